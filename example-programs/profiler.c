@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Statistical profiling of tasks.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * An example program demonstrating the statistical profiler, with a task
+ * spending most of its time in one function.
+ * Every 5 seconds, the samples are printed on the serial line, one per line,
+ * as: "prof <task ID> <program counter> <count>".
+ *
+ * The output can be mapped to symbols with scripts/profile_symbols.py:
+ *
+ *   profile_symbols.py --elf profiler.elf --names worker,report,idle capture
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/profiler.h>
+#include <Lazuli/serial.h>
+
+DEPENDENCY_ON_MODULE(PRINTF);
+DEPENDENCY_ON_MODULE(PROFILER);
+DEPENDENCY_ON_MODULE(SERIAL);
+
+/**
+ * Spin for a while, to simulate some work.
+ *
+ * @param iterations The number of iterations to spin.
+ */
+static void
+Work(uint16_t iterations)
+{
+  volatile uint16_t counter = iterations;
+
+  while (counter > 0) {
+    --counter;
+  }
+}
+
+/**
+ * A function that takes a short time.
+ */
+static void
+ShortFunction(void)
+{
+  Work(1000);
+}
+
+/**
+ * A function that takes a long time.
+ */
+static void
+LongFunction(void)
+{
+  Work(9000);
+}
+
+/**
+ * A task calling 2 functions of different durations.
+ */
+void
+WorkerTask(void)
+{
+  for (;;) {
+    ShortFunction();
+    LongFunction();
+  }
+}
+
+/**
+ * A task periodically printing and resetting the samples of the profiler.
+ */
+void
+ReportTask(void)
+{
+  Lz_ProfilerSample samples[4];
+  uint8_t cursor;
+  uint8_t count;
+  uint8_t i;
+
+  for (;;) {
+    Lz_WaitTimer(250);
+
+    cursor = 0;
+    while (0 != (count = Lz_Profiler_GetSamples(samples,
+                                                ELEMENTS_COUNT(samples),
+                                                &cursor))) {
+      for (i = 0; i < count; ++i) {
+        printf("prof %u %x %u" LZ_CONFIG_SERIAL_NEWLINE,
+               samples[i].taskId,
+               samples[i].pc,
+               samples[i].count);
+      }
+    }
+
+    printf("prof lost %u" LZ_CONFIG_SERIAL_NEWLINE,
+           Lz_Profiler_GetLostSamplesCount());
+
+    Lz_Profiler_Reset();
+  }
+}
+
+/**
+ * Main entry point for user tasks.
+ */
+void
+main(void)
+{
+  Lz_TaskConfiguration taskConfiguration;
+  Lz_SerialConfiguration serialConfiguration;
+
+  /*
+   * Enable serial transmission.
+   */
+  Lz_Serial_GetConfiguration(&serialConfiguration);
+  serialConfiguration.enableFlags = LZ_SERIAL_ENABLE_TRANSMIT;
+  serialConfiguration.speed = LZ_SERIAL_SPEED_19200;
+  Lz_Serial_SetConfiguration(&serialConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "worker";
+  Lz_RegisterTask(WorkerTask, &taskConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "report";
+  /* A higher priority than the worker task */
+  taskConfiguration.priority = -1;
+  Lz_RegisterTask(ReportTask, &taskConfiguration);
+
+  Lz_Run();
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Streaming of the kernel events trace.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * An example program demonstrating the streaming of the kernel events trace
+ * over the serial line, with a cyclic task and a task using the software timer.
+ *
+ * The stream can be decoded with scripts/trace_decode.py:
+ *
+ *   trace_decode.py --names cyclic,timer,trace-stream,idle capture > trace.json
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/serial.h>
+
+DEPENDENCY_ON_MODULE(SERIAL);
+DEPENDENCY_ON_MODULE(TRACE);
+
+STATIC_ASSERT(LZ_CONFIG_TRACE_STREAM,
+              The_configuration_option_LZ_CONFIG_TRACE_STREAM_must_be_set);
+
+/**
+ * Spin for a while, to simulate some work.
+ *
+ * @param iterations The number of iterations to spin.
+ */
+static void
+Work(uint16_t iterations)
+{
+  volatile uint16_t counter = iterations;
+
+  while (counter > 0) {
+    --counter;
+  }
+}
+
+/**
+ * A cyclic task, doing some work at each activation.
+ */
+void
+CyclicTask(void)
+{
+  for (;;) {
+    Work(1000);
+    Lz_Task_WaitActivation();
+  }
+}
+
+/**
+ * A task doing some work, then waiting with the software timer.
+ */
+void
+TimerTask(void)
+{
+  for (;;) {
+    Work(3000);
+    Lz_WaitTimer(3);
+  }
+}
+
+/**
+ * Main entry point for user tasks.
+ */
+void
+main(void)
+{
+  Lz_TaskConfiguration taskConfiguration;
+  Lz_SerialConfiguration serialConfiguration;
+
+  /*
+   * The trace streaming task enables serial transmission, but the speed is
+   * left to the user.
+   */
+  Lz_Serial_GetConfiguration(&serialConfiguration);
+  serialConfiguration.speed = LZ_SERIAL_SPEED_19200;
+  Lz_Serial_SetConfiguration(&serialConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "cyclic";
+  taskConfiguration.schedulingPolicy = CYCLIC_RT;
+  taskConfiguration.period = 5;
+  taskConfiguration.completion = 2;
+  Lz_RegisterTask(CyclicTask, &taskConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "timer";
+  Lz_RegisterTask(TimerTask, &taskConfiguration);
+
+  Lz_Run();
+}
@@ -0,0 +1,172 @@
+#!/usr/bin/gawk -f
+# SPDX-License-Identifier: GPL-3.0-only
+# This file is part of Lazuli.
+# Copyright (c) 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+
+#
+# This script is used to parse the output of benchmarks execution and compare
+# the results with a baseline, in order to detect performance regressions.
+#
+# Reads from stdin.
+# stdout: The results of the benchmarks, one per line, in the form
+#         ``B:name:cycles``. This output can be saved to be used as a baseline.
+# stderr: Comparison with the baseline and execution status.
+#
+# Variables (set with -v):
+# * baseline: The file containing the baseline results. It is read the same way
+#   as the benchmarks output, so a saved output of this script or a raw output
+#   of the target machine can be used. If not set, no comparison is done.
+# * threshold: The tolerated increase of a number of cycles over the baseline,
+#   in percent. Defaults to 0, as simavr is cycle accurate.
+#
+# The output of benchmarks execution must conform to the following
+# specifications:
+#
+# * Benchmarks execution MUST start by outputting the sequence
+#   ``--BEGIN benchmarks:0123456789!``. This is to make sure the serial speed is
+#   set correctly.
+# * Any line starting with ``B:``, and in the form ``B:name:cycles``: The number
+#   of CPU cycles measured for ``name``.
+# * A single ``.``: Means the end of the benchmarks execution.
+#
+# Other lines are ignored. ANSI escape sequences added by simavr and carriage
+# returns are removed.
+#
+# The exit code is 0 if no regression is detected, 1 if a benchmark is slower
+# than its baseline or is missing, and 2 if the output is not recognized.
+#
+
+# Remove the decorations of a line of output.
+function CleanLine(line) {
+    gsub(/\033\[[0-9;]*m/, "", line);
+    gsub(/\r/, "", line);
+
+    return line;
+}
+
+# Return 1 if the line is a benchmark result, and set resultName and
+# resultCycles to its content. Return 0 otherwise.
+function ParseResult(line) {
+    if (line !~ /^B:.*:[0-9]+$/) {
+        return 0;
+    }
+
+    resultCycles = line;
+    sub(/^.*:/, "", resultCycles);
+    resultCycles += 0;
+
+    resultName = line;
+    sub(/^B:/, "", resultName);
+    sub(/:[0-9]+$/, "", resultName);
+
+    return 1;
+}
+
+# Read the baseline results from the given file.
+function ReadBaseline(file,    line) {
+    while ((getline line < file) > 0) {
+        if (ParseResult(CleanLine(line))) {
+            baselineCycles[resultName] = resultCycles;
+        }
+    }
+
+    close(file);
+}
+
+# Compare the result of a benchmark with the baseline.
+function Compare(name, cycles,    reference) {
+    if (!(name in baselineCycles)) {
+        printf("New benchmark: %s: %d cycles\n", name, cycles) > "/dev/stderr";
+
+        return;
+    }
+
+    reference = baselineCycles[name];
+
+    if (cycles * 100 > reference * (100 + threshold)) {
+        regressions++;
+        printf("Regression: %s: %d cycles, baseline %d cycles (%+.1f%%)\n",
+               name,
+               cycles,
+               reference,
+               100.0 * (cycles - reference) / reference) > "/dev/stderr";
+    } else if (cycles < reference) {
+        printf("Improvement: %s: %d cycles, baseline %d cycles (%+.1f%%)\n",
+               name,
+               cycles,
+               reference,
+               100.0 * (cycles - reference) / reference) > "/dev/stderr";
+    }
+}
+
+BEGIN {
+    regressions = 0;
+    hasBegun = 0;
+    hasEnded = 0;
+
+    if ("" == threshold) {
+        threshold = 0;
+    }
+
+    if ("" != baseline) {
+        ReadBaseline(baseline);
+    }
+}
+
+{
+    $0 = CleanLine($0);
+}
+
+!hasBegun && $0 == "--BEGIN benchmarks:0123456789!" {
+    hasBegun = 1;
+
+    next;
+}
+
+!hasBegun {
+    next;
+}
+
+ParseResult($0) {
+    measured[resultName] = 1;
+
+    print "B:" resultName ":" resultCycles;
+
+    if ("" != baseline) {
+        Compare(resultName, resultCycles);
+    }
+}
+
+# End of benchmarks execution.
+/^\.$/ {
+    hasEnded = 1;
+
+    exit;
+}
+
+END {
+    if (!hasBegun || !hasEnded) {
+        printf("Benchmarks execution output is incomplete.\n") > "/dev/stderr";
+
+        exit 2;
+    }
+
+    for (name in baselineCycles) {
+        if (!(name in measured)) {
+            regressions++;
+            printf("Missing benchmark: %s\n", name) > "/dev/stderr";
+        }
+    }
+
+    if (0 == regressions) {
+        printf("No performance regression.\n") > "/dev/stderr";
+
+        exit 0;
+    }
+
+    printf("%d performance regression%s.\n",
+           regressions,
+           regressions > 1 ? "s" : "") > "/dev/stderr";
+
+    exit 1;
+}
@@ -0,0 +1,233 @@
+#! /usr/bin/env python3
+
+# SPDX-License-Identifier: GPL-3.0-only
+# This file is part of Lazuli.
+# Copyright (c) 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+
+"""
+Map the samples of the statistical profiler to the symbols of the program, and
+print a report of where the CPU time is spent, per task and per function.
+
+Samples are read from the serial output of the program, as lines of the form:
+    prof <task ID> <program counter, hexadecimal word address> <count>
+Other lines are ignored. If several dumps are present, samples are summed.
+
+Symbols are read either from the ELF file of the program, or from a listing
+produced with avr-objdump -d.
+
+Usage:
+    profile_symbols.py (--elf FILE | --lst FILE) [--names NAME,...]
+                       [--addresses] [INPUT]
+"""
+
+import argparse
+import collections
+import re
+import struct
+import sys
+
+ANSI_ESCAPE = re.compile(r"\x1b\[[0-9;]*m")
+SAMPLE_LINE = re.compile(r"prof\s+(\d+)\s+([0-9a-fA-F]+)\s+(\d+)")
+LOST_LINE = re.compile(r"prof\s+lost\s+(\d+)")
+LST_SYMBOL = re.compile(r"^([0-9a-fA-F]+) <([^>]+)>:")
+
+SHT_SYMTAB = 2
+STT_NOTYPE = 0
+STT_FUNC = 2
+
+
+def elf_symbols(path):
+    """
+    Read the code symbols of a 32-bit little-endian ELF file.
+
+    Return a sorted list of (byte address, name).
+    """
+    with open(path, "rb") as stream:
+        data = stream.read()
+
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        sys.exit("%s: not a 32-bit little-endian ELF file" % path)
+
+    section_offset, = struct.unpack_from("<I", data, 0x20)
+    section_size, section_count = struct.unpack_from("<HH", data, 0x2E)
+
+    sections = []
+    for index in range(section_count):
+        sections.append(struct.unpack_from(
+            "<IIIIIIIIII", data, section_offset + index * section_size))
+
+    symbols = []
+    for section in sections:
+        if section[1] != SHT_SYMTAB:
+            continue
+
+        strings = sections[section[6]]
+        string_offset = strings[4]
+
+        for offset in range(section[4], section[4] + section[5], section[9]):
+            name, value, _, info, _, shndx = struct.unpack_from(
+                "<IIIBBH", data, offset)
+            symbol_type = info & 0x0F
+
+            if symbol_type not in (STT_NOTYPE, STT_FUNC) or shndx == 0:
+                continue
+
+            # Only keep symbols of sections containing code
+            if shndx >= len(sections) or not sections[shndx][2] & 0x4:
+                continue
+
+            end = data.index(b"\0", string_offset + name)
+            symbol = data[string_offset + name:end].decode("ascii", "replace")
+
+            # Skip local labels generated by the compiler and assembler
+            if symbol and not symbol.startswith("."):
+                symbols.append((value, symbol))
+
+    return sorted(set(symbols))
+
+
+def lst_symbols(path):
+    """
+    Read the symbols of a listing produced with avr-objdump -d.
+
+    Return a sorted list of (byte address, name).
+    """
+    symbols = []
+
+    with open(path) as stream:
+        for line in stream:
+            match = LST_SYMBOL.match(line)
+            if match:
+                symbols.append((int(match.group(1), 16), match.group(2)))
+
+    return sorted(set(symbols))
+
+
+def find_symbol(symbols, address):
+    """Find the symbol containing a byte address, as "symbol+offset"."""
+    low = 0
+    high = len(symbols)
+
+    while low < high:
+        middle = (low + high) // 2
+        if symbols[middle][0] <= address:
+            low = middle + 1
+        else:
+            high = middle
+
+    if low == 0:
+        return "0x%x" % address, "0x%x" % address
+
+    value, name = symbols[low - 1]
+
+    return name, "%s+0x%x" % (name, address - value)
+
+
+def read_samples(stream):
+    """
+    Read the samples from the serial output.
+
+    Return a dict {(task ID, byte address): count}, and the number of lost
+    samples.
+    """
+    samples = collections.Counter()
+    lost = 0
+
+    for line in stream:
+        line = ANSI_ESCAPE.sub("", line)
+
+        match = LOST_LINE.search(line)
+        if match:
+            lost += int(match.group(1))
+            continue
+
+        match = SAMPLE_LINE.search(line)
+        if match:
+            # The program counter is a word address
+            address = int(match.group(2), 16) * 2
+            samples[(int(match.group(1)), address)] += int(match.group(3))
+
+    return samples, lost
+
+
+def task_name(names, task_id):
+    """Get the name of a task from its ID."""
+    if task_id < len(names):
+        return names[task_id]
+
+    return "task %d" % task_id
+
+
+def print_table(title, counter, total):
+    """Print a table of counts sorted in decreasing order."""
+    print(title)
+
+    for key, count in counter.most_common():
+        print("  %6d %5.1f%%  %s" % (count, 100.0 * count / total, key))
+
+    print()
+
+
+def main():
+    """Entry point."""
+    parser = argparse.ArgumentParser(
+        description="Map the samples of the Lazuli profiler to symbols.")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="The serial output to read. Default: standard "
+                        "input.")
+    symbols_group = parser.add_mutually_exclusive_group(required=True)
+    symbols_group.add_argument("--elf", help="The ELF file of the program.")
+    symbols_group.add_argument("--lst",
+                               help="The listing of the program, produced "
+                               "with avr-objdump -d.")
+    parser.add_argument("--names", default="",
+                        help="Comma separated task names, in order of "
+                        "registration.")
+    parser.add_argument("--addresses", action="store_true",
+                        help="Also print the samples of each address.")
+    arguments = parser.parse_args()
+
+    if arguments.elf:
+        symbols = elf_symbols(arguments.elf)
+    else:
+        symbols = lst_symbols(arguments.lst)
+
+    if arguments.input == "-":
+        samples, lost = read_samples(sys.stdin)
+    else:
+        with open(arguments.input, errors="replace") as stream:
+            samples, lost = read_samples(stream)
+
+    total = sum(samples.values())
+    if total == 0:
+        sys.exit("No samples found")
+
+    names = [name for name in arguments.names.split(",") if name]
+    tasks = collections.Counter()
+    functions = collections.Counter()
+    task_functions = collections.defaultdict(collections.Counter)
+    addresses = collections.Counter()
+
+    for (task_id, address), count in samples.items():
+        function, location = find_symbol(symbols, address)
+        name = task_name(names, task_id)
+
+        tasks[name] += count
+        functions[function] += count
+        task_functions[name][function] += count
+        addresses["%s (%s)" % (location, name)] += count
+
+    print("%d samples, %d lost" % (total, lost))
+    print()
+    print_table("Tasks:", tasks, total)
+    print_table("Functions:", functions, total)
+
+    for name, _ in tasks.most_common():
+        print_table("Functions of %s:" % name, task_functions[name], total)
+
+    if arguments.addresses:
+        print_table("Addresses:", addresses, total)
+
+
+if __name__ == "__main__":
+    main()
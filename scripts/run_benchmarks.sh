@@ -0,0 +1,48 @@
+#! /bin/bash
+
+# SPDX-License-Identifier: GPL-3.0-only
+# This file is part of Lazuli.
+# Copyright (c) 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+
+#
+# Bash script to run a benchmarks program in simavr, and compare its results
+# with a baseline.
+#
+# The results are printed on stdout, and can be saved to be used as a baseline.
+# The comparison with the baseline is printed on stderr.
+# The exit code is the one of check_benchmarks_output.awk.
+#
+
+if [ $# -lt 1 ] || [ "$1" = "-h" ]; then
+    echo "$0 usage:"
+    echo "    $0 ELF_FILE [BASELINE_FILE [THRESHOLD]]"
+    echo "    ELF_FILE       The benchmarks program, built with"
+    echo "                   LZ_CONFIG_BUILD_BENCHMARKS"
+    echo "    BASELINE_FILE  The results to compare with"
+    echo "    THRESHOLD      The tolerated increase of cycles, in percent"
+    echo "                   (default: 0)"
+    exit 2
+fi
+
+elf_file=$1
+baseline_file=${2:-}
+threshold=${3:-0}
+
+# Benchmarks run for less than a second of simulated time. The timeout only
+# protects against a program that never ends.
+timeout=60
+
+simavr_command="simavr -m atmega328p -f 16000000"
+
+script_dir=$(dirname "$0")
+
+gawk -v baseline="$baseline_file" \
+     -v threshold="$threshold" \
+     -f "$script_dir"/check_benchmarks_output.awk \
+     < <(exec timeout $timeout $simavr_command "$elf_file" 2>&1)
+status=$?
+
+# The benchmarks program never returns, stop simavr once the results are read.
+kill $! 2> /dev/null
+
+exit $status
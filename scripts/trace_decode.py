@@ -0,0 +1,295 @@
+#! /usr/bin/env python3
+
+# SPDX-License-Identifier: GPL-3.0-only
+# This file is part of Lazuli.
+# Copyright (c) 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+
+"""
+Decode the kernel events trace streamed over the serial line, and convert it to
+a timeline format: Chrome trace JSON (to open in chrome://tracing or Perfetto)
+or VCD (to open in GTKWave).
+
+The stream format is described in sys/kern/modules/trace/trace_stream.c.
+Both binary (SLIP framed) and hexadecimal streams are accepted. The
+hexadecimal stream can be read from a serial console capture or from simavr's
+UART output, other lines being ignored.
+
+Usage:
+    trace_decode.py [--format json|vcd] [--clock-frequency HZ]
+                    [--prescaler N] [--names NAME,...] [INPUT] > OUTPUT
+"""
+
+import argparse
+import json
+import re
+import sys
+
+SLIP_END = 0xC0
+SLIP_ESC = 0xDB
+SLIP_ESC_END = 0xDC
+SLIP_ESC_ESC = 0xDD
+
+FRAME_TYPE_SYNC = 0x80
+FRAME_TYPE_LOST = 0x81
+
+EVENT_NAMES = {
+    0: "context_switch",
+    1: "interrupt",
+    2: "task_wakeup",
+    3: "task_activation",
+    4: "mutex_block",
+    5: "mutex_unblock",
+    6: "timer_expiry",
+}
+
+ANSI_ESCAPE = re.compile(r"\x1b\[[0-9;]*m")
+HEX_LINE = re.compile(r"^(?:[0-9A-F]{2})+$")
+
+
+def slip_frames(data):
+    """Split a binary stream into unescaped SLIP frames."""
+    frame = bytearray()
+    escaped = False
+
+    for byte in data:
+        if escaped:
+            frame.append({SLIP_ESC_END: SLIP_END,
+                          SLIP_ESC_ESC: SLIP_ESC}.get(byte, byte))
+            escaped = False
+        elif byte == SLIP_ESC:
+            escaped = True
+        elif byte == SLIP_END:
+            if frame:
+                yield bytes(frame)
+            frame = bytearray()
+        else:
+            frame.append(byte)
+
+
+def hex_frames(data):
+    """Extract frames from a text stream, one frame per hexadecimal line."""
+    for line in data.decode("ascii", errors="replace").splitlines():
+        # simavr replaces the control characters of its UART output (e.g. the
+        # carriage return of CRLF new lines) by dots.
+        line = ANSI_ESCAPE.sub("", line).strip().rstrip(".")
+
+        if HEX_LINE.match(line):
+            yield bytes.fromhex(line)
+
+
+def is_hex_stream(data):
+    """Check if a stream only contains printable text."""
+    return all(byte in (0x09, 0x0A, 0x0D, 0x1B) or 0x20 <= byte < 0x7F
+               for byte in data)
+
+
+def read_varint(frame, position):
+    """Decode an unsigned LEB128 integer. Return (value, next position)."""
+    value = 0
+    shift = 0
+
+    while True:
+        byte = frame[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+
+        if not byte & 0x80:
+            return value, position
+
+
+def decode(frames):
+    """
+    Decode frames to a list of events.
+
+    Each event is a dict with keys: time (absolute, in timer counts), event,
+    data. Lost records are reported with event "lost".
+    """
+    events = []
+    tick = 0
+    counter = 0
+    period = None
+
+    for frame in frames:
+        try:
+            frame_type = frame[0]
+
+            if frame_type == FRAME_TYPE_SYNC:
+                sync_tick = frame[1] | (frame[2] << 8)
+                counter = frame[3] | (frame[4] << 8)
+                period = frame[5] | (frame[6] << 8)
+                tick += (sync_tick - tick) & 0xFFFF
+                continue
+
+            if frame_type == FRAME_TYPE_LOST:
+                count, _ = read_varint(frame, 1)
+                events.append({"time": None, "event": "lost", "data": count})
+                continue
+
+            if period is None:
+                # No absolute time reference yet
+                continue
+
+            data = frame[1]
+            delta_tick, position = read_varint(frame, 2)
+            timestamp, _ = read_varint(frame, position)
+        except IndexError:
+            sys.stderr.write("Truncated frame: %s\n" % frame.hex())
+            continue
+
+        if delta_tick == 0:
+            counter = (counter + timestamp) & 0xFFFF
+        else:
+            tick += delta_tick
+            counter = timestamp
+
+        events.append({
+            "time": tick * period + counter,
+            "event": EVENT_NAMES.get(frame_type, "event_%d" % frame_type),
+            "data": data,
+        })
+
+    # Lost records are placed at the time of the next record
+    next_time = None
+    for event in reversed(events):
+        if event["time"] is None:
+            event["time"] = next_time
+        else:
+            next_time = event["time"]
+
+    return [event for event in events if event["time"] is not None]
+
+
+def task_name(names, task_id):
+    """Get the name of a task from its ID."""
+    if task_id < len(names):
+        return names[task_id]
+
+    return "task %d" % task_id
+
+
+def to_chrome_json(events, count_us, names):
+    """Convert events to the Chrome trace event format."""
+    trace_events = []
+    running = None
+
+    for event in events:
+        timestamp = event["time"] * count_us
+
+        if event["event"] == "context_switch":
+            if running is not None:
+                trace_events.append({
+                    "name": task_name(names, running[0]),
+                    "ph": "X",
+                    "pid": 1,
+                    "tid": 1,
+                    "ts": running[1],
+                    "dur": timestamp - running[1],
+                })
+            running = (event["data"], timestamp)
+        else:
+            if event["event"] in ("interrupt", "lost"):
+                arguments = {"value": event["data"]}
+            else:
+                arguments = {"task": task_name(names, event["data"])}
+
+            trace_events.append({
+                "name": event["event"],
+                "ph": "i",
+                "s": "t",
+                "pid": 1,
+                "tid": 1,
+                "ts": timestamp,
+                "args": arguments,
+            })
+
+    trace_events.append({
+        "name": "thread_name",
+        "ph": "M",
+        "pid": 1,
+        "tid": 1,
+        "args": {"name": "CPU"},
+    })
+
+    return json.dumps({"traceEvents": trace_events}, indent=1)
+
+
+def to_vcd(events, count_ns, names):
+    """Convert events to the Value Change Dump format."""
+    identifiers = {"task": "!"}
+    for index, name in enumerate(sorted(set(EVENT_NAMES.values()) |
+                                        {"lost"})):
+        identifiers[name] = chr(ord('"') + index)
+
+    lines = [
+        "$comment Lazuli kernel events trace $end",
+        "$timescale %d ns $end" % count_ns,
+        "$scope module lazuli $end",
+        "$var wire 8 ! task $end",
+    ]
+
+    for name, identifier in sorted(identifiers.items()):
+        if name != "task":
+            lines.append("$var event 1 %s %s $end" % (identifier, name))
+
+    lines += ["$upscope $end", "$enddefinitions $end"]
+
+    if names:
+        lines.insert(1, "$comment tasks: %s $end" % ", ".join(
+            "%d=%s" % (index, name) for index, name in enumerate(names)))
+
+    current_time = None
+    for event in events:
+        if event["time"] != current_time:
+            current_time = event["time"]
+            lines.append("#%d" % current_time)
+
+        if event["event"] == "context_switch":
+            lines.append("b{0:08b} !".format(event["data"]))
+        else:
+            lines.append("1%s" % identifiers[event["event"]])
+
+    return "\n".join(lines)
+
+
+def main():
+    """Entry point."""
+    parser = argparse.ArgumentParser(
+        description="Decode the Lazuli kernel events trace stream.")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="The stream to decode. Default: standard input.")
+    parser.add_argument("--format", choices=("json", "vcd"), default="json",
+                        help="The output format. Default: json.")
+    parser.add_argument("--clock-frequency", type=int, default=16000000,
+                        help="The machine clock frequency, in Hertz.")
+    parser.add_argument("--prescaler", type=int, default=8,
+                        help="The prescaler of the system timer.")
+    parser.add_argument("--names", default="",
+                        help="Comma separated task names, in order of "
+                        "registration.")
+    arguments = parser.parse_args()
+
+    if arguments.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(arguments.input, "rb") as stream:
+            data = stream.read()
+
+    if is_hex_stream(data):
+        frames = hex_frames(data)
+    else:
+        frames = slip_frames(data)
+
+    events = decode(frames)
+    names = [name for name in arguments.names.split(",") if name]
+
+    if arguments.format == "json":
+        count_us = arguments.prescaler * 1e6 / arguments.clock_frequency
+        print(to_chrome_json(events, count_us, names))
+    else:
+        count_ns = round(arguments.prescaler * 1e9 / arguments.clock_frequency)
+        print(to_vcd(events, count_ns, names))
+
+
+if __name__ == "__main__":
+    main()
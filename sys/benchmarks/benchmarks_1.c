@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks suite part 1 - Printf.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains benchmarks for printf-related functionalities.
+ */
+
+#include "benchmarks_common.h"
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+
+#include <Lazuli/sys/printf.h>
+
+DEPENDENCY_ON_MODULE(PRINTF);
+
+/**
+ * Former implementation of Printf_ConvertU16ToDecimal(), kept as a reference.
+ *
+ * @param i The 16-bit input value to convert.
+ * @param buffer A valid pointer to an allocated string of minimum size 5 bytes.
+ *
+ * @return The number of characters actually written to the buffer.
+ */
+uint8_t
+Reference_ConvertU16ToDecimal(uint16_t i, char buffer[]);
+
+BENCHMARK(ConvertU16ToDecimal_Reference)
+{
+  char buffer[5];
+  uint16_t cycles;
+
+  Benchmark_Start();
+  Reference_ConvertU16ToDecimal(7, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Reference_ConvertU16ToDecimal(7)", cycles);
+
+  Benchmark_Start();
+  Reference_ConvertU16ToDecimal(999, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Reference_ConvertU16ToDecimal(999)", cycles);
+
+  Benchmark_Start();
+  Reference_ConvertU16ToDecimal(65535, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Reference_ConvertU16ToDecimal(65535)", cycles);
+}
+
+BENCHMARK(ConvertU16ToDecimal)
+{
+  char buffer[5];
+  uint16_t cycles;
+
+  Benchmark_Start();
+  Printf_ConvertU16ToDecimal(7, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU16ToDecimal(7)", cycles);
+
+  Benchmark_Start();
+  Printf_ConvertU16ToDecimal(999, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU16ToDecimal(999)", cycles);
+
+  Benchmark_Start();
+  Printf_ConvertU16ToDecimal(65535, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU16ToDecimal(65535)", cycles);
+}
+
+BENCHMARK(ConvertU32ToDecimal)
+{
+  char buffer[10];
+  uint16_t cycles;
+
+  Benchmark_Start();
+  Printf_ConvertU32ToDecimal(65535UL, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU32ToDecimal(65535)", cycles);
+
+  Benchmark_Start();
+  Printf_ConvertU32ToDecimal(16777216UL, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU32ToDecimal(16777216)", cycles);
+
+  Benchmark_Start();
+  Printf_ConvertU32ToDecimal(4294967295UL, buffer);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Printf_ConvertU32ToDecimal(4294967295)", cycles);
+}
+
+void
+ExecuteBenchmarks(void)
+{
+  ConvertU16ToDecimal_Reference();
+  ConvertU16ToDecimal();
+  ConvertU32ToDecimal();
+}
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks suite part 2 - Memory and strings.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains benchmarks for memory and string functions.
+ * Each function is compared to an equivalent byte loop written in C.
+ */
+
+#include "benchmarks_common.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+
+#include <Lazuli/sys/memory.h>
+
+DEPENDENCY_ON_MODULE(STRING);
+
+/**
+ * Prevent the compiler from replacing the reference loops by calls to the
+ * functions we compare them to.
+ */
+#define REFERENCE __attribute__((noinline,                              \
+                                 optimize("no-tree-loop-distribute-patterns")))
+
+/**
+ * Size of the buffers used for benchmarks.
+ */
+#define BUFFER_SIZE (128)
+
+static uint8_t source[BUFFER_SIZE];
+static uint8_t destination[BUFFER_SIZE];
+
+/**
+ * Former implementation of Memory_Copy(), kept as a reference.
+ */
+REFERENCE static void
+ReferenceCopy(const void *src, void *dest, const size_t size)
+{
+  size_t i;
+  const uint8_t *sourceBytes = src;
+  uint8_t *destinationBytes = dest;
+
+  for (i = 0; i < size; ++i) {
+    destinationBytes[i] = sourceBytes[i];
+  }
+}
+
+/**
+ * Reference byte loop for memset().
+ */
+REFERENCE static void
+ReferenceSet(void *s, const int c, const size_t n)
+{
+  size_t i;
+  uint8_t *bytes = s;
+
+  for (i = 0; i < n; ++i) {
+    bytes[i] = (uint8_t)c;
+  }
+}
+
+/**
+ * Reference byte loop for strcmp().
+ */
+REFERENCE static int
+ReferenceStrcmp(const char *s1, const char *s2)
+{
+  while ('\0' != *s1 && *s1 == *s2) {
+    ++s1;
+    ++s2;
+  }
+
+  return (unsigned char)*s1 - (unsigned char)*s2;
+}
+
+BENCHMARK(Copy)
+{
+  uint16_t cycles;
+
+  Benchmark_Start();
+  ReferenceCopy(source, destination, 16);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("ReferenceCopy(16)", cycles);
+
+  Benchmark_Start();
+  ReferenceCopy(source, destination, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("ReferenceCopy(128)", cycles);
+
+  Benchmark_Start();
+  Memory_Copy(source, destination, 16);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Memory_Copy(16)", cycles);
+
+  Benchmark_Start();
+  Memory_Copy(source, destination, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Memory_Copy(128)", cycles);
+
+  Benchmark_Start();
+  memcpy(destination, source, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("memcpy(128)", cycles);
+
+  Benchmark_Start();
+  memmove(destination + 1, destination, BUFFER_SIZE - 1);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("memmove(127)", cycles);
+}
+
+BENCHMARK(Set)
+{
+  uint16_t cycles;
+
+  Benchmark_Start();
+  ReferenceSet(destination, 0x55, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("ReferenceSet(128)", cycles);
+
+  Benchmark_Start();
+  memset(destination, 0x55, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("memset(128)", cycles);
+}
+
+BENCHMARK(Compare)
+{
+  uint16_t cycles;
+
+  memset(source, 'a', BUFFER_SIZE);
+  source[BUFFER_SIZE - 1] = '\0';
+  memcpy(destination, source, BUFFER_SIZE);
+
+  Benchmark_Start();
+  ReferenceStrcmp((const char *)source, (const char *)destination);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("ReferenceStrcmp(127)", cycles);
+
+  Benchmark_Start();
+  strcmp((const char *)source, (const char *)destination);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("strcmp(127)", cycles);
+
+  Benchmark_Start();
+  memcmp(source, destination, BUFFER_SIZE);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("memcmp(128)", cycles);
+}
+
+void
+ExecuteBenchmarks(void)
+{
+  Copy();
+  Set();
+  Compare();
+}
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks suite part 3 - Kernel primitives.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains benchmarks for kernel primitives that can be measured
+ * without running the scheduler: the 16-bit division, uncontended mutexes and
+ * printf() with common formats.
+ */
+
+#include "benchmarks_common.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/mutex.h>
+
+#include <Lazuli/sys/arch/AVR/timer_counter_1.h>
+#include <Lazuli/sys/arch/AVR/usart.h>
+#include <Lazuli/sys/arch/arch.h>
+
+DEPENDENCY_ON_MODULE(DIVISION);
+DEPENDENCY_ON_MODULE(MUTEX);
+DEPENDENCY_ON_MODULE(PRINTF);
+
+/**
+ * Number of CPU cycles needed to transmit one character on the serial line at
+ * 19200 bauds, with a margin. A frame is 10 bits long.
+ */
+#define CHARACTER_CYCLES                                                \
+  ((uint16_t)((LZ_CONFIG_MACHINE_CLOCK_FREQUENCY / 19200UL) * 12UL))
+
+/**
+ * Wait until the serial line has transmitted all pending characters.
+ *
+ * printf() writes characters to the serial line and waits while the transmit
+ * buffer is full. When the line is idle, the transmit buffer accepts one
+ * character without waiting. So printf() with a format whose output is only
+ * one character is measured without the time of transmission.
+ */
+static void
+WaitSerialLineIdle(void)
+{
+  while (!(UCSR0A & UCSR0A_UDRE0));
+
+  Benchmark_Start();
+  while (TCNT1 < CHARACTER_CYCLES);
+  Benchmark_Stop();
+}
+
+/**
+ * Print the result of a printf() benchmark, after the output of the measured
+ * call.
+ *
+ * @param name The name of the measured code.
+ * @param cycles The number of CPU cycles measured.
+ */
+static void
+ReportPrintf(const char * const name, const uint16_t cycles)
+{
+  /* The output of the measured call stands on its own line */
+  puts("");
+
+  Benchmark_Report(name, cycles);
+}
+
+BENCHMARK(Divide_U16)
+{
+  uint16_t cycles;
+
+  Benchmark_Start();
+  Arch_Divide_U16(15, 1);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Arch_Divide_U16(15/1)", cycles);
+
+  Benchmark_Start();
+  Arch_Divide_U16(21447, 325);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Arch_Divide_U16(21447/325)", cycles);
+
+  Benchmark_Start();
+  Arch_Divide_U16(64683, 173);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Arch_Divide_U16(64683/173)", cycles);
+
+  Benchmark_Start();
+  Arch_Divide_U16(65535, 10);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Arch_Divide_U16(65535/10)", cycles);
+
+  Benchmark_Start();
+  Arch_Divide_U16(65535, 0);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Arch_Divide_U16(65535/0)", cycles);
+}
+
+/*
+ * The scheduler is not running yet, and the clock tick interrupt is disabled.
+ * Mutexes can then be used from here as long as they are not contended.
+ */
+BENCHMARK(MutexUncontended)
+{
+  Lz_Mutex mutex;
+  uint16_t cycles;
+
+  Lz_Mutex_Init(&mutex);
+
+  Benchmark_Start();
+  Lz_Mutex_Lock(&mutex);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Lz_Mutex_Lock(uncontended)", cycles);
+
+  Benchmark_Start();
+  Lz_Mutex_Unlock(&mutex);
+  cycles = Benchmark_Stop();
+  Benchmark_Report("Lz_Mutex_Unlock(uncontended)", cycles);
+}
+
+BENCHMARK(Printf)
+{
+  uint16_t cycles;
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("a");
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(literal)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%c", 'a');
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%c)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%s", "a");
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%s)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%d", 7);
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%d)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%u", 7U);
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%u)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%x", 0xaU);
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%x)", cycles);
+
+  WaitSerialLineIdle();
+  Benchmark_Start();
+  printf("%lu", 7UL);
+  cycles = Benchmark_Stop();
+  ReportPrintf("printf(%lu)", cycles);
+}
+
+void
+ExecuteBenchmarks(void)
+{
+  Divide_U16();
+  MutexUncontended();
+  Printf();
+}
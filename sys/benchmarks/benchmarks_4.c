@@ -0,0 +1,337 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks suite part 4 - Scheduler.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains benchmarks for the paths of the scheduler: the clock tick,
+ * the wake up of tasks waiting for a software timer, a mutex and an interrupt.
+ *
+ * These benchmarks run under the scheduler, so Timer/Counter 1 keeps being the
+ * system timer. In order to measure exact numbers of CPU cycles, the benchmark
+ * task sets its prescaler to 1 when it starts. The counter then gives the
+ * number of CPU cycles elapsed since the last clock tick, and time slices are 8
+ * times shorter.
+ *
+ * Measures are taken at the beginning of a time slice, so they are never
+ * interrupted by a clock tick.
+ *
+ * The tasks are:
+ * - The benchmark task, with the highest priority. It drives all the measures
+ *   and reports the results.
+ * - The holder and trigger tasks, that take part in the mutex and interrupt
+ *   measures. They wait on a locked mutex until the benchmark task needs them.
+ * - Sleeper tasks, that wait for a software timer that never expires during
+ *   the benchmarks. They make the list of tasks waiting for a software timer
+ *   grow, one task per time slice.
+ */
+
+#include "benchmarks_common.h"
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/mutex.h>
+
+#include <Lazuli/sys/arch/AVR/registers.h>
+#include <Lazuli/sys/arch/AVR/timer_counter_1.h>
+#include <Lazuli/sys/arch/arch.h>
+
+DEPENDENCY_ON_MODULE(MUTEX);
+
+/**
+ * The number of sleeper tasks.
+ */
+#define SLEEPERS_COUNT (4)
+
+/**
+ * The stack size of the benchmark task, that calls printf().
+ */
+#define BENCHMARK_TASK_STACK_SIZE (200)
+
+/**
+ * The pin of the external interrupt INT0 (PD2).
+ */
+#define INT0_PIN (POSITION(2U))
+
+/**
+ * The bit of INT0 in the registers EIMSK and EIFR.
+ */
+#define INT0_BIT (POSITION(0U))
+
+/**
+ * The value of EICRA to request INT0 on a rising edge.
+ */
+#define INT0_RISING_EDGE (POSITION(1U) | POSITION(0U))
+
+/**
+ * The number of CPU cycles taken by reading the counter of Timer/Counter 1.
+ */
+static uint16_t readOverhead;
+
+/**
+ * The number of sleeper tasks that went waiting for their software timer.
+ */
+static volatile uint8_t sleepersCount = 0;
+
+/**
+ * Indicates that the benchmark task is about to lock the contended mutex.
+ */
+static volatile bool isLockRequested = false;
+
+/**
+ * CPU cycles taken by Lz_Mutex_Unlock() when a task waits for the mutex.
+ */
+static volatile uint16_t unlockContendedCycles;
+
+/**
+ * CPU cycles taken by the handler of INT0, when it wakes up one task.
+ */
+static volatile uint16_t interruptHandlerCycles;
+
+/**
+ * The mutex that the holder and benchmark tasks contend for.
+ */
+static Lz_Mutex contendedMutex = LZ_MUTEX_INIT;
+
+/**
+ * The mutex that the holder task waits for before taking part in the measures.
+ */
+static Lz_Mutex holderGate = LZ_MUTEX_INIT_LOCKED;
+
+/**
+ * The mutex that the trigger task waits for before taking part in the
+ * measures.
+ */
+static Lz_Mutex triggerGate = LZ_MUTEX_INIT_LOCKED;
+
+/**
+ * Get the number of CPU cycles elapsed since a given value of the counter.
+ *
+ * @param begin The value of the counter at the beginning of the measure.
+ *
+ * @return The number of CPU cycles elapsed, without the overhead of the
+ *         measure itself.
+ */
+static uint16_t
+Elapsed(const uint16_t begin)
+{
+  const uint16_t end = TCNT1;
+
+  return end - begin - readOverhead;
+}
+
+/**
+ * Measure the duration of a clock tick that elects the task that was running.
+ *
+ * The counter is read in a loop until it restarts from 0. The duration of a
+ * loop iteration without clock tick is removed from the result.
+ *
+ * @return The number of CPU cycles taken by the clock tick.
+ */
+static uint16_t
+MeasureClockTick(void)
+{
+  const uint16_t period = Arch_GetSystemTimerPeriod();
+  uint16_t step = UINT16_MAX;
+  uint16_t previous;
+  uint16_t current = TCNT1;
+
+  do {
+    previous = current;
+    current = TCNT1;
+
+    if (current > previous && (current - previous) < step) {
+      step = current - previous;
+    }
+  } while (current >= previous);
+
+  return current + (period - previous) - step;
+}
+
+/**
+ * Raise an edge on the pin of INT0.
+ *
+ * The pin is read a few times after the edge, to leave time to the edge
+ * detector to request the interrupt.
+ */
+static void
+RaiseInterrupt(void)
+{
+  uint8_t i;
+
+  PORTD |= INT0_PIN;
+
+  for (i = 0; i < 4; ++i) {
+    (void)PIND;
+  }
+
+  PORTD &= ~INT0_PIN;
+}
+
+/**
+ * A task waiting for a software timer that never expires.
+ */
+static void
+SleeperTask(void)
+{
+  for (;;) {
+    ++sleepersCount;
+    Lz_WaitTimer(UINT16_MAX);
+  }
+}
+
+/**
+ * A task holding the contended mutex, until the benchmark task waits for it.
+ */
+static void
+HolderTask(void)
+{
+  uint16_t begin;
+
+  Lz_Mutex_Lock(&holderGate);
+  Lz_Mutex_Lock(&contendedMutex);
+
+  /* The benchmark task is blocked on the mutex at the next time slice */
+  while (!isLockRequested);
+
+  begin = TCNT1;
+  Lz_Mutex_Unlock(&contendedMutex);
+  unlockContendedCycles = Elapsed(begin);
+
+  Lz_Task_Terminate();
+}
+
+/**
+ * A task raising INT0 while the benchmark task waits for it.
+ *
+ * The same edge is first measured with INT0 disabled, and this reference is
+ * removed from the measure with INT0 enabled.
+ */
+static void
+TriggerTask(void)
+{
+  uint16_t begin;
+  uint16_t reference;
+
+  Lz_Mutex_Lock(&triggerGate);
+
+  EIMSK &= ~INT0_BIT;
+  begin = TCNT1;
+  RaiseInterrupt();
+  reference = Elapsed(begin);
+
+  /* Clear the request of the reference edge */
+  EIFR = INT0_BIT;
+  EIMSK |= INT0_BIT;
+
+  begin = TCNT1;
+  RaiseInterrupt();
+  interruptHandlerCycles = Elapsed(begin) - reference;
+
+  Lz_Task_Terminate();
+}
+
+/**
+ * The task driving all the measures.
+ */
+static void
+BenchmarkTask(void)
+{
+  uint16_t wakeupCycles[SLEEPERS_COUNT + 1];
+  uint16_t clockTickCycles;
+  uint16_t lockContendedCycles;
+  uint16_t waitInterruptCycles;
+  uint16_t begin;
+  uint8_t count;
+
+  /* Keep CTC mode, and clock the timer without prescaler */
+  TCCR1B = TCCR1B_WGM12 | TCCR1B_CS10;
+
+  begin = TCNT1;
+  readOverhead = TCNT1 - begin;
+
+  /*
+   * Wake up from a software timer, while the sleeper tasks go waiting one by
+   * one. The tasks elected while the benchmark task waits are, in order: the
+   * holder and trigger tasks, each sleeper task, then the idle task.
+   */
+  do {
+    Lz_WaitTimer(1);
+    wakeupCycles[sleepersCount] = TCNT1;
+  } while (sleepersCount < SLEEPERS_COUNT);
+
+  Lz_WaitTimer(1);
+  clockTickCycles = MeasureClockTick();
+
+  /* Mutex contended with the holder task */
+  Lz_Mutex_Unlock(&holderGate);
+  Lz_WaitTimer(1);
+  isLockRequested = true;
+  Lz_Mutex_Lock(&contendedMutex);
+  lockContendedCycles = TCNT1;
+  Lz_Mutex_Unlock(&contendedMutex);
+
+  /* Interrupt raised by the trigger task */
+  EICRA = INT0_RISING_EDGE;
+  PORTD &= ~INT0_PIN;
+  DDRD |= INT0_PIN;
+  Lz_Mutex_Unlock(&triggerGate);
+  Lz_Task_WaitInterrupt(INT_INT0);
+  waitInterruptCycles = TCNT1;
+  EIMSK &= ~INT0_BIT;
+
+  for (count = 0; count <= SLEEPERS_COUNT; ++count) {
+    Benchmark_ReportWithParameter("Lz_WaitTimer_Wakeup",
+                                  count,
+                                  wakeupCycles[count]);
+  }
+
+  Benchmark_Report("ClockTick(same task)", clockTickCycles);
+  Benchmark_Report("Lz_Mutex_Unlock(contended)", unlockContendedCycles);
+  Benchmark_Report("Lz_Mutex_Lock_Wakeup(contended)", lockContendedCycles);
+  Benchmark_Report("INT0_Handler(1 task woken)", interruptHandlerCycles);
+  Benchmark_Report("Lz_Task_WaitInterrupt_Wakeup", waitInterruptCycles);
+
+  Benchmark_Terminate();
+}
+
+void
+ExecuteBenchmarks(void)
+{
+  Lz_TaskConfiguration taskConfiguration;
+  uint8_t i;
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "benchmark";
+  taskConfiguration.stackSize = BENCHMARK_TASK_STACK_SIZE;
+  taskConfiguration.priority = -2;
+  Lz_RegisterTask(BenchmarkTask, &taskConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "holder";
+  taskConfiguration.priority = -1;
+  Lz_RegisterTask(HolderTask, &taskConfiguration);
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "trigger";
+  taskConfiguration.priority = -1;
+  Lz_RegisterTask(TriggerTask, &taskConfiguration);
+
+  for (i = 0; i < SLEEPERS_COUNT; ++i) {
+    Lz_TaskConfiguration_Init(&taskConfiguration);
+    taskConfiguration.name = "sleeper";
+    Lz_RegisterTask(SleeperTask, &taskConfiguration);
+  }
+
+  /* The calibration of the measure has stopped the system timer */
+  Arch_InitSystemTimer();
+
+  Lz_Run();
+}
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks micro framework.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains the common utility definitions for the Lazuli kernel
+ * benchmarks suite.
+ */
+
+#include "benchmarks_common.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/serial.h>
+
+#include <Lazuli/sys/arch/AVR/timer_counter_1.h>
+
+DEPENDENCY_ON_MODULE(PRINTF);
+DEPENDENCY_ON_MODULE(SERIAL);
+
+/**
+ * Number of cycles taken by an empty measure.
+ */
+static uint16_t overhead = 0;
+
+void
+Benchmark_Start(void)
+{
+  TCCR1B = 0;
+  TCNT1 = 0;
+  TCCR1B = TCCR1B_CS10; /* No prescaling */
+}
+
+uint16_t
+Benchmark_Stop(void)
+{
+  TCCR1B = 0;
+
+  return TCNT1 - overhead;
+}
+
+void
+Benchmark_Report(const char * const name, const uint16_t cycles)
+{
+  printf("B:%s:%u" LZ_CONFIG_SERIAL_NEWLINE, name, cycles);
+}
+
+void
+Benchmark_ReportWithParameter(const char * const name,
+                              const uint16_t parameter,
+                              const uint16_t cycles)
+{
+  printf("B:%s(%u):%u" LZ_CONFIG_SERIAL_NEWLINE, name, parameter, cycles);
+}
+
+void
+Benchmark_Terminate(void)
+{
+  puts("." LZ_CONFIG_SERIAL_NEWLINE);
+
+  for (;;);
+}
+
+/**
+ * Measure the overhead of Benchmark_Start() and Benchmark_Stop(), in order to
+ * remove it from each measure.
+ */
+static void
+CalibrateMeasure(void)
+{
+  TCCR1A = 0; /* Normal mode */
+  TIMSK1 = 0;
+
+  Benchmark_Start();
+  overhead = Benchmark_Stop();
+}
+
+/**
+ * Activate serial transmission.
+ */
+static void
+EnableSerialTransmission(void) {
+  Lz_SerialConfiguration serialConfiguration;
+
+  Lz_Serial_GetConfiguration(&serialConfiguration);
+  serialConfiguration.enableFlags = LZ_SERIAL_ENABLE_TRANSMIT;
+  serialConfiguration.speed = LZ_SERIAL_SPEED_19200;
+  Lz_Serial_SetConfiguration(&serialConfiguration);
+}
+
+void
+main(void)
+{
+  EnableSerialTransmission();
+  CalibrateMeasure();
+
+  puts(LZ_CONFIG_SERIAL_NEWLINE
+       "--BEGIN benchmarks:0123456789!"
+       LZ_CONFIG_SERIAL_NEWLINE);
+
+  ExecuteBenchmarks();
+
+  Benchmark_Terminate();
+}
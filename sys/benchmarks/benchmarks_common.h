@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel benchmarks micro framework API.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains the common utility declarations for the Lazuli kernel
+ * benchmarks suite.
+ *
+ * Benchmarks measure the number of CPU cycles spent in a piece of code, using
+ * the Timer/Counter 1 clocked without prescaler.
+ * Results are printed on the serial line, one per line, in the form
+ * ``B:name:cycles``.
+ */
+
+#ifndef BENCHMARKS_COMMON_H
+#define BENCHMARKS_COMMON_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+
+/**
+ * Execute all benchmarks.
+ *
+ * Benchmarks that need the scheduler don't return from this function. They
+ * must then call Benchmark_Terminate() themselves once all results are
+ * reported.
+ */
+void
+ExecuteBenchmarks(void);
+
+/**
+ * Declare a benchmark.
+ *
+ * @param N The name of the benchmark to declare.
+ */
+#define BENCHMARK(N) static void N(void)
+
+/**
+ * Start measuring CPU cycles.
+ */
+void
+Benchmark_Start(void);
+
+/**
+ * Stop measuring CPU cycles.
+ *
+ * @return The number of CPU cycles elapsed since the last call to
+ *         Benchmark_Start(), without the overhead of the measure itself.
+ *
+ * @warning The measured code must take less than 65536 CPU cycles.
+ */
+uint16_t
+Benchmark_Stop(void);
+
+/**
+ * Print the result of a benchmark on the serial line.
+ *
+ * @param name The name of the measured code.
+ * @param cycles The number of CPU cycles measured.
+ */
+void
+Benchmark_Report(const char * const name, const uint16_t cycles);
+
+/**
+ * Print the result of a benchmark depending on a parameter on the serial line,
+ * in the form ``B:name(parameter):cycles``.
+ *
+ * @param name The name of the measured code.
+ * @param parameter The value of the parameter of the measure.
+ * @param cycles The number of CPU cycles measured.
+ */
+void
+Benchmark_ReportWithParameter(const char * const name,
+                              const uint16_t parameter,
+                              const uint16_t cycles);
+
+/**
+ * Print the end of the benchmarks execution on the serial line, and stop.
+ *
+ * This function never returns.
+ */
+void
+Benchmark_Terminate(void);
+
+#endif /* BENCHMARKS_COMMON_H */
@@ -114,6 +114,102 @@ option(
 
 mark_as_advanced(LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES)
 
+option(
+  LZ_CONFIG_INSTRUMENT_TASK_ID
+  "When set, output the ID of the running task on a group of pins."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_TASK_ID)
+
+option(
+  LZ_CONFIG_INSTRUMENT_INTERRUPTS
+  "When set, add instrumentation code to measure interrupt handlers."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_INTERRUPTS)
+
+option(
+  LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS
+  "When set, measure the longest time during which interrupts are disabled."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS)
+
+option(
+  LZ_CONFIG_INSTRUMENT_STACK_USAGE
+  "When set, paint task stacks to measure their high-water mark."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_STACK_USAGE)
+
+option(
+  LZ_CONFIG_INSTRUMENT_CPU_USAGE
+  "When set, account the CPU time consumed by each task."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_CPU_USAGE)
+
+option(
+  LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS
+  "When set, measure the jitter and response time of cyclic tasks jobs."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS)
+
+option(
+  LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS
+  "When set, count ticks, context switches, idle ticks and interrupts."
+  OFF)
+
+mark_as_advanced(LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS)
+
+option(
+  LZ_CONFIG_SCHEDULABILITY_ANALYSIS
+  "When set, provide the schedulability analysis of cyclic tasks."
+  OFF)
+
+option(
+  LZ_CONFIG_CHECK_SCHEDULABILITY_AT_RUN
+  "When set, panic at Lz_Run() if the cyclic tasks are not schedulable."
+  OFF)
+
+option(
+  LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS
+  "When set, allow the kernel to choose the release offsets of cyclic tasks."
+  OFF)
+
+option(
+  LZ_CONFIG_TIME_TRIGGERED_SCHEDULING
+  "When set, dispatch tasks from a schedule table built before compilation."
+  OFF)
+
+option(
+  LZ_CONFIG_TASK_BUDGETS
+  "When set, allow priority real-time tasks to be given a CPU budget."
+  OFF)
+
+option(
+  LZ_CONFIG_BASIC_TASKS
+  "When set, allow run-to-completion basic tasks sharing a single stack."
+  OFF)
+
+set(
+  LZ_CONFIG_BASIC_TASKS_STACK_SIZE
+  128
+  CACHE STRING
+  "The stack size in bytes shared by all basic tasks.")
+
+set(
+  LZ_CONFIG_CLOCK_TICK_OVERHEAD
+  125
+  CACHE STRING
+  "Worst-case duration of a clock tick, in system timer counts.")
+
+option(
+  LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW
+  "Check for task stack overflows at each clock tick."
+  ON)
+
 ## Spinlocks
 
 option(
@@ -148,6 +244,53 @@ option(
   OFF)
 
 
+## Trace
+
+set(
+  LZ_CONFIG_TRACE_BUFFER_SIZE
+  32
+  CACHE STRING
+  "The number of records of the kernel events trace, as a power of 2.")
+
+option(
+  LZ_CONFIG_TRACE_STREAM
+  "Stream the kernel events trace over the serial line from a kernel task."
+  OFF)
+
+option(
+  LZ_CONFIG_TRACE_STREAM_HEX
+  "Stream the trace as lines of hexadecimal digits instead of binary frames."
+  OFF)
+
+set(
+  LZ_CONFIG_TRACE_STREAM_TASK_STACK_SIZE
+  100
+  CACHE STRING
+  "The stack size in bytes of the trace streaming task.")
+
+## Profiler
+
+set(
+  LZ_CONFIG_PROFILER_TABLE_SIZE
+  32
+  CACHE STRING
+  "The number of entries of the profiler hash table, as a power of 2.")
+
+## Interrupt latency
+
+set(
+  LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE
+  8
+  CACHE STRING
+  "The number of buckets of the interrupt latency histograms.")
+
+set(
+  LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT
+  12
+  CACHE STRING
+  "The width of interrupt latency buckets, as a power of 2 of timer counts.")
+
+
 ## AVR-specific
 
 option(
@@ -195,3 +338,27 @@ set(
   "The position in the port used for instrumentation on AVR machines.")
 
 mark_as_advanced(LZ_CONFIG_AVR_INSTRUMENT_POSITION)
+
+set(
+  LZ_CONFIG_AVR_INSTRUMENT_INTERRUPTS_POSITION
+  6
+  CACHE STRING
+  "The position in the instrumentation port used for interrupt handlers.")
+
+mark_as_advanced(LZ_CONFIG_AVR_INSTRUMENT_INTERRUPTS_POSITION)
+
+set(
+  LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT
+  0x28
+  CACHE STRING
+  "The port used to output the ID of the running task on AVR machines.")
+
+mark_as_advanced(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT)
+
+set(
+  LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK
+  0x0F
+  CACHE STRING
+  "The mask of the pins used to output the ID of the running task on AVR.")
+
+mark_as_advanced(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK)
@@ -0,0 +1,364 @@
+# SPDX-License-Identifier: GPL-3.0-only
+# This file is part of Lazuli.
+# Copyright (c) 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+
+#
+# CMake script building the schedule table of the time-triggered scheduler from
+# a set of cyclic real-time tasks. It is run at build time, before compilation:
+#     cmake -DTASK_SET=tasks.txt -DOUTPUT=schedule_table.h \
+#           -P schedule_table.cmake
+#
+# TASK_SET is the set of tasks, in the same format as the one of the
+# schedulability analyzer: one task per line, as
+# PERIOD COMPLETION [DEADLINE] [NAME]. Durations are expressed in time slices,
+# and the deadline is equal to the period if it is omitted. Empty lines are
+# ignored, and '#' starts a comment until the end of the line.
+#
+# OUTPUT is the header to write. It declares the table ScheduleTable, to give
+# to Lz_SetScheduleTable().
+#
+# FIRST_TASK_ID is the ID of the task of the first line, 0 by default. Tasks
+# must be registered in the order of the lines, with no other task registered
+# in between, so the task of each line gets the ID FIRST_TASK_ID + line index.
+#
+# The table spans one hyperperiod, i.e. the least common multiple of the
+# periods. It is built by simulating the deadline monotonic scheduling of the
+# tasks, all released at the first slot, each job running for its whole
+# completion time. Tasks of equal deadlines are ordered by period, then by
+# order of the lines. The script fails if a job misses its deadline.
+#
+
+cmake_minimum_required(VERSION 3.12)
+
+# The highest number of slots of a table, as its length is 16-bit wide.
+set(MAX_SLOTS 65535)
+
+# The highest task ID, as the ID 127 marks the slots of the idle task.
+set(MAX_TASK_ID 126)
+
+# The values of LZ_SCHEDULE_SLOT_IDLE and LZ_SCHEDULE_SLOT_JOB_START.
+set(SLOT_IDLE 127)
+set(SLOT_JOB_START 128)
+
+# The number of slots per line of the generated table.
+set(SLOTS_PER_LINE 12)
+
+if(NOT DEFINED TASK_SET OR NOT DEFINED OUTPUT)
+  message(
+    FATAL_ERROR
+    "Usage: cmake -DTASK_SET=FILE -DOUTPUT=FILE [-DFIRST_TASK_ID=ID]"
+    " -P schedule_table.cmake")
+endif()
+
+if(NOT DEFINED FIRST_TASK_ID)
+  set(FIRST_TASK_ID 0)
+endif()
+
+if(NOT FIRST_TASK_ID MATCHES "^[0-9]+$" OR FIRST_TASK_ID GREATER MAX_TASK_ID)
+  message(FATAL_ERROR "FIRST_TASK_ID must be between 0 and ${MAX_TASK_ID}.")
+endif()
+
+#
+# Parse the set of tasks.
+#
+
+if(NOT EXISTS "${TASK_SET}")
+  message(FATAL_ERROR "${TASK_SET}: Unable to open the file.")
+endif()
+
+file(READ "${TASK_SET}" content)
+
+# Lines are separated by ';', so a ';' in the file would break them.
+string(REPLACE ";" "," content "${content}")
+string(REPLACE "\n" ";" lines "${content}")
+
+set(tasksCount 0)
+set(lineNumber 0)
+
+foreach(line IN LISTS lines)
+  math(EXPR lineNumber "${lineNumber} + 1")
+
+  string(REGEX REPLACE "#.*$" "" line "${line}")
+  string(REGEX MATCHALL "[^ \t\r]+" fields "${line}")
+  list(LENGTH fields fieldsCount)
+
+  if(0 EQUAL fieldsCount)
+    continue()
+  endif()
+
+  set(name "")
+  set(deadline 0)
+  list(GET fields 0 period)
+
+  if(fieldsCount GREATER 1)
+    list(GET fields 1 completion)
+  else()
+    set(completion "")
+  endif()
+
+  # A name never starts with a digit, so a number is a deadline
+  if(fieldsCount GREATER 2)
+    list(GET fields 2 field)
+
+    if(field MATCHES "^[0-9]")
+      set(deadline ${field})
+      set(nameIndex 3)
+    else()
+      set(nameIndex 2)
+    endif()
+
+    if(fieldsCount GREATER nameIndex)
+      list(GET fields ${nameIndex} name)
+      math(EXPR nameIndex "${nameIndex} + 1")
+    endif()
+  else()
+    set(nameIndex 2)
+  endif()
+
+  if(NOT period MATCHES "^[0-9]+$" OR
+     NOT completion MATCHES "^[0-9]+$" OR
+     NOT deadline MATCHES "^[0-9]+$" OR
+     fieldsCount GREATER nameIndex)
+    message(
+      FATAL_ERROR
+      "${TASK_SET}:${lineNumber}:"
+      " Expected: PERIOD COMPLETION [DEADLINE] [NAME]")
+  endif()
+
+  if(0 EQUAL deadline)
+    set(deadline ${period})
+  endif()
+
+  if(period LESS 1 OR period GREATER 65535 OR
+     completion LESS 1 OR completion GREATER 65535 OR
+     deadline GREATER period)
+    message(
+      FATAL_ERROR
+      "${TASK_SET}:${lineNumber}: Invalid task, period and completion must be"
+      " between 1 and 65535, and deadline must not be greater than period.")
+  endif()
+
+  math(EXPR taskId "${FIRST_TASK_ID} + ${tasksCount}")
+  if(taskId GREATER MAX_TASK_ID)
+    message(
+      FATAL_ERROR
+      "${TASK_SET}:${lineNumber}: Too many tasks, the highest task ID is"
+      " ${MAX_TASK_ID}.")
+  endif()
+
+  if("" STREQUAL name)
+    set(name "-")
+  endif()
+
+  set(TASK_${tasksCount}_PERIOD ${period})
+  set(TASK_${tasksCount}_COMPLETION ${completion})
+  set(TASK_${tasksCount}_DEADLINE ${deadline})
+  set(TASK_${tasksCount}_NAME ${name})
+  set(TASK_${tasksCount}_ID ${taskId})
+  math(EXPR tasksCount "${tasksCount} + 1")
+endforeach()
+
+if(0 EQUAL tasksCount)
+  message(FATAL_ERROR "${TASK_SET}: The set of tasks is empty.")
+endif()
+
+math(EXPR lastTask "${tasksCount} - 1")
+
+#
+# Compute the hyperperiod, i.e. the least common multiple of the periods.
+#
+
+set(hyperperiod 1)
+
+foreach(i RANGE ${lastTask})
+  set(a ${hyperperiod})
+  set(b ${TASK_${i}_PERIOD})
+
+  while(NOT 0 EQUAL b)
+    math(EXPR remainder "${a} % ${b}")
+    set(a ${b})
+    set(b ${remainder})
+  endwhile()
+
+  math(EXPR hyperperiod "${hyperperiod} / ${a} * ${TASK_${i}_PERIOD}")
+
+  if(hyperperiod GREATER MAX_SLOTS)
+    message(
+      FATAL_ERROR
+      "${TASK_SET}: The hyperperiod of the tasks is greater than ${MAX_SLOTS}"
+      " time slices.")
+  endif()
+endforeach()
+
+#
+# Order the tasks by priority: deadline, then period, then order of the lines.
+# Keys are padded with zeros, so they sort as numbers.
+#
+
+set(keys "")
+
+foreach(i RANGE ${lastTask})
+  set(key "")
+
+  foreach(value ${TASK_${i}_DEADLINE} ${TASK_${i}_PERIOD} ${i})
+    set(padded "${value}")
+    string(LENGTH "${padded}" length)
+
+    while(length LESS 5)
+      set(padded "0${padded}")
+      math(EXPR length "${length} + 1")
+    endwhile()
+
+    string(APPEND key "${padded}")
+  endforeach()
+
+  list(APPEND keys "${key}")
+endforeach()
+
+list(SORT keys)
+
+set(priorityOrder "")
+
+foreach(key IN LISTS keys)
+  string(SUBSTRING "${key}" 10 5 index)
+  math(EXPR index "${index}")
+  list(APPEND priorityOrder ${index})
+endforeach()
+
+#
+# Simulate the deadline monotonic scheduling over one hyperperiod.
+#
+
+foreach(i RANGE ${lastTask})
+  set(TASK_${i}_REMAINING 0)
+  set(TASK_${i}_IS_STARTED FALSE)
+  set(TASK_${i}_ABSOLUTE_DEADLINE 0)
+endforeach()
+
+set(slots "")
+set(idleSlotsCount 0)
+math(EXPR lastSlot "${hyperperiod} - 1")
+
+foreach(slot RANGE ${lastSlot})
+  set(elected "")
+
+  foreach(i IN LISTS priorityOrder)
+    # Release a new job
+    math(EXPR phase "${slot} % ${TASK_${i}_PERIOD}")
+    if(0 EQUAL phase)
+      set(TASK_${i}_REMAINING ${TASK_${i}_COMPLETION})
+      set(TASK_${i}_IS_STARTED FALSE)
+      math(EXPR TASK_${i}_ABSOLUTE_DEADLINE "${slot} + ${TASK_${i}_DEADLINE}")
+    endif()
+
+    if("" STREQUAL elected AND TASK_${i}_REMAINING GREATER 0)
+      set(elected ${i})
+    endif()
+  endforeach()
+
+  if("" STREQUAL elected)
+    list(APPEND slots ${SLOT_IDLE})
+    math(EXPR idleSlotsCount "${idleSlotsCount} + 1")
+  else()
+    if(TASK_${elected}_IS_STARTED)
+      list(APPEND slots ${TASK_${elected}_ID})
+    else()
+      math(EXPR entry "${SLOT_JOB_START} + ${TASK_${elected}_ID}")
+      list(APPEND slots ${entry})
+      set(TASK_${elected}_IS_STARTED TRUE)
+    endif()
+
+    math(
+      EXPR
+      TASK_${elected}_REMAINING
+      "${TASK_${elected}_REMAINING} - 1")
+  endif()
+
+  # At the end of the slot, no pending job may have reached its deadline
+  math(EXPR slotEnd "${slot} + 1")
+
+  foreach(i RANGE ${lastTask})
+    if(TASK_${i}_REMAINING GREATER 0 AND
+       NOT slotEnd LESS TASK_${i}_ABSOLUTE_DEADLINE)
+      message(
+        FATAL_ERROR
+        "${TASK_SET}: Not schedulable, task ${TASK_${i}_ID}"
+        " (${TASK_${i}_NAME}) misses its deadline at time slice ${slotEnd}.")
+    endif()
+  endforeach()
+endforeach()
+
+#
+# Write the header.
+#
+
+get_filename_component(taskSetName "${TASK_SET}" NAME)
+
+set(header "")
+
+string(
+  APPEND
+  header
+  "/*\n"
+  " * Schedule table of the time-triggered scheduler of Lazuli.\n"
+  " *\n"
+  " * Generated from ${taskSetName} by schedule_table.cmake, do not edit.\n"
+  " *\n"
+  " * Register the cyclic real-time tasks in this order, then call:\n"
+  " * Lz_SetScheduleTable(ScheduleTable, ELEMENTS_COUNT(ScheduleTable));\n"
+  " *\n"
+  " * ID  Period  Completion  Deadline  Name\n")
+
+foreach(i RANGE ${lastTask})
+  string(
+    APPEND
+    header
+    " * ${TASK_${i}_ID}  ${TASK_${i}_PERIOD}  ${TASK_${i}_COMPLETION}"
+    "  ${TASK_${i}_DEADLINE}  ${TASK_${i}_NAME}\n")
+endforeach()
+
+string(
+  APPEND
+  header
+  " *\n"
+  " * Slots: ${hyperperiod}, idle: ${idleSlotsCount}.\n"
+  " * A slot is the ID of a task, plus ${SLOT_JOB_START} where a job begins\n"
+  " * (LZ_SCHEDULE_SLOT_JOB_START), or ${SLOT_IDLE} where the idle task runs\n"
+  " * (LZ_SCHEDULE_SLOT_IDLE).\n"
+  " */\n"
+  "\n"
+  "#ifndef LAZULI_SCHEDULE_TABLE_H\n"
+  "#define LAZULI_SCHEDULE_TABLE_H\n"
+  "\n"
+  "#include <stdint.h>\n"
+  "\n"
+  "#include <Lazuli/common.h>\n"
+  "#include <Lazuli/sys/compiler.h>\n"
+  "\n"
+  "static PROGMEM const uint8_t ScheduleTable[] = {")
+
+set(column 0)
+set(separator "")
+
+foreach(entry IN LISTS slots)
+  if(0 EQUAL column)
+    string(APPEND header "${separator}\n ")
+  else()
+    string(APPEND header "${separator}")
+  endif()
+
+  string(APPEND header " ${entry}")
+  set(separator ",")
+
+  math(EXPR column "(${column} + 1) % ${SLOTS_PER_LINE}")
+endforeach()
+
+string(
+  APPEND
+  header
+  "\n"
+  "};\n"
+  "\n"
+  "#endif /* LAZULI_SCHEDULE_TABLE_H */\n")
+
+file(WRITE "${OUTPUT}" "${header}")
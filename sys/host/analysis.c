@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Schedulability analysis of a set of tasks for the host build.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file registers a set of cyclic real-time tasks in the kernel, exactly
+ * like an application does, and runs the schedulability analysis of the
+ * kernel on them. The scheduler is never started.
+ *
+ * This file belongs to the kernel side, see host.h.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+
+#include <Lazuli/sys/arch/arch.h>
+
+#include "host.h"
+
+/**
+ * The response times computed by the kernel.
+ */
+static Lz_TaskResponseTime responseTimes[ANALYSIS_MAX_TASKS];
+
+/**
+ * The number of registered tasks.
+ */
+static unsigned int tasksCount = 0;
+
+/**
+ * The entry point of all analyzed tasks, that is never executed.
+ */
+static void
+TaskEntryPoint(void)
+{
+  Host_Abort("The entry point of an analyzed task has been executed.");
+}
+
+/** @name Kernel side, schedulability analysis */
+/** @{                                         */
+
+int
+Analysis_AddTask(unsigned long period,
+                 unsigned long completion,
+                 unsigned long deadline,
+                 const char *name)
+{
+  Lz_TaskConfiguration taskConfiguration;
+
+  if (tasksCount >= ANALYSIS_MAX_TASKS ||
+      0 == period ||
+      period > UINT16_MAX ||
+      0 == completion ||
+      completion > UINT16_MAX ||
+      deadline > period) {
+    return 0;
+  }
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = name;
+  taskConfiguration.schedulingPolicy = CYCLIC_RT;
+  taskConfiguration.period = (lz_u_resolution_unit_t)period;
+  taskConfiguration.completion = (lz_u_resolution_unit_t)completion;
+  taskConfiguration.deadline = (lz_u_resolution_unit_t)deadline;
+
+  if (!Lz_RegisterTask(TaskEntryPoint, &taskConfiguration)) {
+    return 0;
+  }
+
+  ++tasksCount;
+
+  return 1;
+}
+
+unsigned int
+Analysis_Run(AnalysisResults *results,
+             AnalysisTaskResult *tasks,
+             unsigned int tableSize)
+{
+  Lz_SchedulabilityAnalysis analysis;
+  uint8_t count;
+  uint8_t i;
+
+  count = Lz_AnalyzeSchedulability(&analysis,
+                                   responseTimes,
+                                   ELEMENTS_COUNT(responseTimes));
+
+  results->tasksCount = analysis.cyclicTasksCount;
+  results->utilization = analysis.cyclicUtilization;
+  results->tickOverhead = analysis.tickOverhead;
+  results->cpuLoad = analysis.cpuLoad;
+  results->liuLaylandBound = analysis.liuLaylandBound;
+  results->isUnderLiuLaylandBound = analysis.isUnderLiuLaylandBound;
+  results->isSchedulable = analysis.isSchedulable;
+  results->timeSlice = Arch_GetSystemTimerPeriod();
+  results->clockTick = LZ_CONFIG_CLOCK_TICK_OVERHEAD;
+
+  for (i = 0; i < count && i < tableSize; ++i) {
+    tasks[i].name = responseTimes[i].name;
+    tasks[i].period = responseTimes[i].period;
+    tasks[i].completion = responseTimes[i].completion;
+    tasks[i].deadline = responseTimes[i].deadline;
+    tasks[i].responseTime = responseTimes[i].responseTime;
+    tasks[i].availableExecutionTime = responseTimes[i].availableExecutionTime;
+    tasks[i].isSchedulable = responseTimes[i].isSchedulable;
+  }
+
+  return i;
+}
+
+/** @} */
@@ -0,0 +1,332 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Host program analyzing the schedulability of a set of tasks.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This program reads a set of cyclic real-time tasks from a file, registers
+ * them in the kernel built for the host, and prints the result of the
+ * schedulability analysis of the kernel.
+ *
+ * Each line of the file describes a task as:
+ * PERIOD COMPLETION [DEADLINE] [NAME]. Durations are expressed in time slices,
+ * and the deadline is equal to the period if it is omitted. Empty lines are
+ * ignored, and '#' starts a comment until the end of the line.
+ *
+ * The program exits with:
+ * - 0 if the set of tasks is schedulable.
+ * - 1 if the set of tasks is not schedulable.
+ * - 2 if the file can't be read or is invalid.
+ *
+ * This file belongs to the host side, see host.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+
+/**
+ * The exit code of the program when the set of tasks is schedulable.
+ */
+#define EXIT_SCHEDULABLE (0)
+
+/**
+ * The exit code of the program when the set of tasks is not schedulable.
+ */
+#define EXIT_NOT_SCHEDULABLE (1)
+
+/**
+ * The exit code of the program when the file can't be read or is invalid.
+ */
+#define EXIT_INVALID_INPUT (2)
+
+/**
+ * The maximum length of a line of the file, including the end of line.
+ */
+#define MAX_LINE_LENGTH (256)
+
+/**
+ * The maximum length of the name of a task.
+ */
+#define MAX_NAME_LENGTH (31)
+
+/**
+ * The names of the tasks, that must stay valid during the analysis.
+ */
+static char names[ANALYSIS_MAX_TASKS][MAX_NAME_LENGTH + 1];
+
+/**
+ * The response times of the tasks.
+ */
+static AnalysisTaskResult tasks[ANALYSIS_MAX_TASKS];
+
+/**
+ * Parse the description of a task: PERIOD COMPLETION [DEADLINE] [NAME].
+ *
+ * @param line The line to parse, without comment.
+ * @param period A pointer to the variable receiving the period.
+ * @param completion A pointer to the variable receiving the completion time.
+ * @param deadline A pointer to the variable receiving the deadline, set to 0
+ *                 if the line has no deadline.
+ * @param name A pointer to a buffer of MAX_NAME_LENGTH + 1 characters
+ *             receiving the name, set to an empty string if the line has no
+ *             name.
+ *
+ * @return
+ *         - 1 if the line describes a task.
+ *         - 0 if the line is empty.
+ *         - -1 if the line is invalid.
+ */
+static int
+ParseTask(const char *line,
+          unsigned long *period,
+          unsigned long *completion,
+          unsigned long *deadline,
+          char *name)
+{
+  char extra;
+  int length = 0;
+  int fieldsCount;
+
+  *deadline = 0;
+  name[0] = '\0';
+
+  fieldsCount = sscanf(line, "%lu %lu %n", period, completion, &length);
+  if (EOF == fieldsCount) {
+    return 0;
+  }
+
+  if (fieldsCount < 2) {
+    return -1;
+  }
+
+  line += length;
+
+  /* A name never starts with a digit, so a number is a deadline */
+  if (*line >= '0' && *line <= '9') {
+    length = 0;
+    if (sscanf(line, "%lu %n", deadline, &length) < 1) {
+      return -1;
+    }
+
+    line += length;
+  }
+
+  fieldsCount = sscanf(line, "%31s %c", name, &extra);
+
+  return EOF == fieldsCount || 1 == fieldsCount ? 1 : -1;
+}
+
+/**
+ * Read the set of tasks from a file, and register them in the kernel.
+ *
+ * @param file The file to read.
+ * @param fileName The name of the file, for error messages.
+ *
+ * @return
+ *         - 1 if all tasks have been registered.
+ *         - 0 if the file is invalid or if a task can't be registered.
+ */
+static int
+ReadTasks(FILE *file, const char *fileName)
+{
+  char line[MAX_LINE_LENGTH];
+  char name[MAX_NAME_LENGTH + 1];
+  char *comment;
+  unsigned long lineNumber = 0;
+  unsigned long period;
+  unsigned long completion;
+  unsigned long deadline;
+  unsigned int tasksCount = 0;
+  int status;
+
+  while (NULL != fgets(line, sizeof(line), file)) {
+    ++lineNumber;
+
+    if (NULL == strchr(line, '\n') && !feof(file)) {
+      fprintf(stderr, "%s:%lu: Line too long.\n", fileName, lineNumber);
+
+      return 0;
+    }
+
+    comment = strchr(line, '#');
+    if (NULL != comment) {
+      *comment = '\0';
+    }
+
+    status = ParseTask(line, &period, &completion, &deadline, name);
+    if (0 == status) {
+      continue;
+    }
+
+    if (status < 0) {
+      fprintf(stderr,
+              "%s:%lu: Expected: PERIOD COMPLETION [DEADLINE] [NAME]\n",
+              fileName,
+              lineNumber);
+
+      return 0;
+    }
+
+    if (tasksCount >= ANALYSIS_MAX_TASKS) {
+      fprintf(stderr,
+              "%s:%lu: Too many tasks, the maximum is %d.\n",
+              fileName,
+              lineNumber,
+              ANALYSIS_MAX_TASKS);
+
+      return 0;
+    }
+
+    strcpy(names[tasksCount], name);
+
+    if (!Analysis_AddTask(period,
+                          completion,
+                          deadline,
+                          '\0' == names[tasksCount][0] ?
+                          NULL : names[tasksCount])) {
+      fprintf(stderr,
+              "%s:%lu: Invalid task, period and completion must be between 1"
+              " and 65535, and deadline must not be greater than period.\n",
+              fileName,
+              lineNumber);
+
+      return 0;
+    }
+
+    ++tasksCount;
+  }
+
+  if (ferror(file)) {
+    fprintf(stderr, "%s: Unable to read the file.\n", fileName);
+
+    return 0;
+  }
+
+  return 1;
+}
+
+/**
+ * Print a ratio expressed in permille, as a percentage.
+ *
+ * @param label The label of the ratio.
+ * @param ratio The ratio, in permille.
+ */
+static void
+PrintRatio(const char *label, const unsigned int ratio)
+{
+  printf("%s: %u.%u%%", label, ratio / 10, ratio % 10);
+}
+
+/**
+ * Print the results of the analysis.
+ *
+ * @param results A pointer to the results of the analysis.
+ * @param tasksCount The number of elements of the table of tasks.
+ */
+static void
+PrintResults(const AnalysisResults *results, const unsigned int tasksCount)
+{
+  unsigned int i;
+
+  printf("%-*s %8s %10s %8s %8s %12s %s\n",
+         MAX_NAME_LENGTH,
+         "Task",
+         "Period",
+         "Completion",
+         "Deadline",
+         "Response",
+         "Available",
+         "Schedulable");
+
+  for (i = 0; i < tasksCount; ++i) {
+    printf("%-*s %8lu %10lu %8lu %8lu %12lu %s\n",
+           MAX_NAME_LENGTH,
+           NULL == tasks[i].name ? "-" : tasks[i].name,
+           tasks[i].period,
+           tasks[i].completion,
+           tasks[i].deadline,
+           tasks[i].responseTime,
+           tasks[i].availableExecutionTime,
+           tasks[i].isSchedulable ? "yes" : "no");
+  }
+
+  printf("\n");
+  printf("Cyclic tasks: %u\n", results->tasksCount);
+  PrintRatio("Utilization", results->utilization);
+  printf("\n");
+  PrintRatio("Clock tick overhead", results->tickOverhead);
+  printf(" (%lu of %lu system timer counts per time slice)\n",
+         results->clockTick,
+         results->timeSlice);
+  PrintRatio("CPU load", results->cpuLoad);
+  printf("\n");
+  PrintRatio("Liu-Layland bound", results->liuLaylandBound);
+  printf(", %s\n", results->isUnderLiuLaylandBound ? "respected" : "exceeded");
+  printf("Schedulable: %s\n", results->isSchedulable ? "yes" : "no");
+}
+
+void
+Host_ReturnToSimulation(void)
+{
+  /* The scheduler is never started by the analysis */
+  Host_Abort("The scheduler has been started.");
+}
+
+void
+Host_ClockTickBegin(void)
+{
+}
+
+void
+Host_Abort(const char *message)
+{
+  fprintf(stderr, "Analysis aborted: %s\n", message);
+
+  exit(EXIT_INVALID_INPUT);
+}
+
+int
+main(int argc, char **argv)
+{
+  AnalysisResults results;
+  FILE *file;
+  unsigned int tasksCount;
+  int isValid;
+
+  if (2 != argc) {
+    fprintf(stderr,
+            "Usage: %s FILE\n"
+            "  FILE  The set of tasks, one per line:\n"
+            "        PERIOD COMPLETION [DEADLINE] [NAME]\n"
+            "        Durations are expressed in time slices.\n",
+            argv[0]);
+
+    return EXIT_INVALID_INPUT;
+  }
+
+  file = fopen(argv[1], "r");
+  if (NULL == file) {
+    fprintf(stderr, "%s: Unable to open the file.\n", argv[1]);
+
+    return EXIT_INVALID_INPUT;
+  }
+
+  isValid = ReadTasks(file, argv[1]);
+  fclose(file);
+
+  if (!isValid) {
+    return EXIT_INVALID_INPUT;
+  }
+
+  tasksCount = Analysis_Run(&results, tasks, ANALYSIS_MAX_TASKS);
+  PrintResults(&results, tasksCount);
+
+  return results.isSchedulable ? EXIT_SCHEDULABLE : EXIT_NOT_SCHEDULABLE;
+}
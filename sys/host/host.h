@@ -0,0 +1,270 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Interface between the simulated kernel and the host program.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * The host build is made of two sides:
+ * - The kernel side: the scheduler, the modules, the simulated architecture
+ *   layer and the simulated tasks. They are compiled with the Lazuli headers,
+ *   exactly as they are for the target machine.
+ * - The host side: the program driving the simulation. It is compiled with
+ *   the C library of the host.
+ *
+ * The types defined by the Lazuli headers conflict with the ones of the host
+ * C library, so a translation unit can't belong to both sides. This header is
+ * the only one included by both sides, and only uses the types of the C
+ * language.
+ */
+
+#ifndef LAZULI_HOST_HOST_H
+#define LAZULI_HOST_HOST_H
+
+/**
+ * The maximum number of tasks of a simulation.
+ *
+ * Task IDs are 8-bit wide, and one ID is taken by the idle task.
+ */
+#define SIMULATION_MAX_TASKS (254)
+
+/**
+ * Results of a simulation, measured by the kernel side.
+ *
+ * Durations are expressed in clock ticks.
+ */
+typedef struct {
+  /** The number of clock ticks simulated */
+  unsigned long ticks;
+
+  /** The number of clock ticks that elected another task than the last one */
+  unsigned long contextSwitches;
+
+  /** The number of time slices given to the idle task */
+  unsigned long idleTicks;
+
+  /** The number of wake ups of tasks, i.e. of recorded latencies */
+  unsigned long wakeups;
+
+  /** The sum of all wake up latencies */
+  unsigned long wakeupLatencySum;
+
+  /** The longest wake up latency */
+  unsigned long wakeupLatencyMax;
+
+  /** The number of wake ups with no latency, i.e. on time */
+  unsigned long wakeupsOnTime;
+
+  /** The number of times a task found a mutex locked */
+  unsigned long mutexContentions;
+
+  /** The number of jobs completed by cyclic tasks */
+  unsigned long cyclicJobs;
+
+  /** The number of runs to completion of basic tasks */
+  unsigned long basicTaskJobs;
+}SimulationResults;
+
+/**
+ * @name Host side
+ *
+ * Functions implemented by the host program, for the kernel side.
+ *
+ * @{
+ */
+
+/**
+ * Return to the simulation loop of the host program.
+ *
+ * This is how the simulated architecture layer gives hand to the elected task:
+ * the host program then runs its next time slice.
+ */
+__attribute__((noreturn)) void
+Host_ReturnToSimulation(void);
+
+/**
+ * Notify the host program that a clock tick begins.
+ *
+ * The clock tick ends when Host_ReturnToSimulation() is called.
+ */
+void
+Host_ClockTickBegin(void);
+
+/**
+ * Stop the simulation because of an error.
+ *
+ * @param message A description of the error.
+ */
+__attribute__((noreturn)) void
+Host_Abort(const char *message);
+
+/** @} */
+
+/**
+ * @name Kernel side
+ *
+ * Functions implemented by the simulation, for the host program.
+ *
+ * @{
+ */
+
+/**
+ * Register the tasks of a simulation.
+ *
+ * @param tasksCount The number of tasks to register, the idle task excluded.
+ * @param seed The seed of the pseudo-random generator used to build the set
+ *             of tasks and to simulate interrupts.
+ *
+ * @return
+ *         - 1 if the tasks have been registered.
+ *         - 0 if the parameters are invalid or if the kernel ran out of memory.
+ */
+int
+Simulation_Init(unsigned int tasksCount, unsigned long seed);
+
+/**
+ * Start the scheduler.
+ *
+ * This function never returns, it gives hand to the host program by calling
+ * Host_ReturnToSimulation() once the first task is elected.
+ */
+void
+Simulation_Start(void);
+
+/**
+ * Run the time slice of the elected task, until the next clock tick.
+ *
+ * This function never returns, it gives hand to the host program by calling
+ * Host_ReturnToSimulation() once the clock tick has elected the next task.
+ */
+void
+Simulation_RunTimeSlice(void);
+
+/**
+ * Get the results of the simulation.
+ *
+ * @param results A pointer to the SimulationResults to fill.
+ */
+void
+Simulation_GetResults(SimulationResults *results);
+
+/** @} */
+
+/**
+ * The maximum number of tasks of a schedulability analysis.
+ *
+ * One task ID is kept for the idle task, so the analyzed set of tasks can be
+ * run as is.
+ */
+#define ANALYSIS_MAX_TASKS (254)
+
+/**
+ * The worst-case response time of a task, computed by the kernel side.
+ *
+ * Durations are expressed in time slices, unless otherwise stated.
+ */
+typedef struct {
+  /** The name of the task */
+  const char *name;
+
+  /** The period of the task */
+  unsigned long period;
+
+  /** The completion time of the task */
+  unsigned long completion;
+
+  /** The relative deadline of the task */
+  unsigned long deadline;
+
+  /** The worst-case response time of the task */
+  unsigned long responseTime;
+
+  /** The execution time available to a job, in system timer counts */
+  unsigned long availableExecutionTime;
+
+  /** 1 if the task meets its deadlines, 0 otherwise */
+  int isSchedulable;
+}AnalysisTaskResult;
+
+/**
+ * Results of a schedulability analysis, computed by the kernel side.
+ *
+ * Ratios are expressed in permille.
+ */
+typedef struct {
+  /** The number of analyzed tasks */
+  unsigned int tasksCount;
+
+  /** The utilization of the CPU by the tasks */
+  unsigned int utilization;
+
+  /** The share of each time slice taken by the clock tick */
+  unsigned int tickOverhead;
+
+  /** The load of the CPU, clock ticks included */
+  unsigned int cpuLoad;
+
+  /** The Liu-Layland bound for this number of tasks */
+  unsigned int liuLaylandBound;
+
+  /** 1 if the utilization is under the Liu-Layland bound, 0 otherwise */
+  int isUnderLiuLaylandBound;
+
+  /** 1 if all tasks meet their deadlines, 0 otherwise */
+  int isSchedulable;
+
+  /** The duration of a time slice, in system timer counts */
+  unsigned long timeSlice;
+
+  /** The duration of a clock tick, in system timer counts */
+  unsigned long clockTick;
+}AnalysisResults;
+
+/**
+ * @name Kernel side, schedulability analysis
+ *
+ * Functions implemented by the analysis, for the host program.
+ *
+ * @{
+ */
+
+/**
+ * Register a cyclic real-time task to analyze.
+ *
+ * @param period The period of the task, in time slices.
+ * @param completion The completion time of the task, in time slices.
+ * @param deadline The relative deadline of the task, in time slices, or 0 if
+ *                 it is equal to the period.
+ * @param name The name of the task, that must stay valid during the analysis.
+ *
+ * @return
+ *         - 1 if the task has been registered.
+ *         - 0 if the parameters are invalid or if the kernel ran out of memory.
+ */
+int
+Analysis_AddTask(unsigned long period,
+                 unsigned long completion,
+                 unsigned long deadline,
+                 const char *name);
+
+/**
+ * Analyze the schedulability of the registered tasks.
+ *
+ * @param results A pointer to the AnalysisResults to fill.
+ * @param tasks A pointer to a table of AnalysisTaskResult to fill, in the order
+ *              of registration of tasks.
+ * @param tableSize The number of elements of the table @p tasks.
+ *
+ * @return The number of elements of @p tasks that have been filled.
+ */
+unsigned int
+Analysis_Run(AnalysisResults *results,
+             AnalysisTaskResult *tasks,
+             unsigned int tableSize);
+
+/** @} */
+
+#endif /* LAZULI_HOST_HOST_H */
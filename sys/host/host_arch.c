@@ -0,0 +1,391 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Simulated architecture layer for the host build.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file replaces, for the host build, the architecture specific code of
+ * the kernel, and the parts of the kernel that can't be compiled for the host:
+ * the memory allocator, the kernel panic and the assembly implementations.
+ *
+ * Tasks are simulated and never execute code on their own stack. So the
+ * context of a task is not saved nor restored: "returning from interrupt" to a
+ * task means giving hand to the host program, that runs the next time slice of
+ * the elected task. The clock tick is the only source of context switches, and
+ * happens when the running task sleeps or ends its time slice.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/spinlock.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/kernel.h>
+#include <Lazuli/sys/memory.h>
+#include <Lazuli/sys/scheduler.h>
+#include <Lazuli/sys/task.h>
+
+#include "host.h"
+
+/**
+ * The size in bytes of the memory available to the kernel allocator.
+ */
+#define KERNEL_MEMORY_SIZE (1024UL * 1024UL)
+
+/**
+ * The alignment of the memory blocks returned by the kernel allocator, so the
+ * host can access the pointers they contain.
+ */
+#define KERNEL_MEMORY_ALIGNMENT (sizeof(uintmax_t))
+
+/**
+ * The period of the system timer, in timer counts.
+ *
+ * The same value as the Timer/Counter 1 of the AVR with a prescaler of 8.
+ */
+#define SYSTEM_TIMER_PERIOD                                             \
+  ((uint16_t)(LZ_CONFIG_MACHINE_CLOCK_FREQUENCY /                       \
+              (8UL * LZ_CONFIG_SYSTEM_CLOCK_RESOLUTION_FREQUENCY)))
+
+volatile lz_system_status_t systemStatus = SYSTEM_STATUS_FLAG_IN_KERNEL;
+
+/**
+ * The memory available to the kernel allocator.
+ */
+static uintmax_t kernelMemory[KERNEL_MEMORY_SIZE / sizeof(uintmax_t)];
+
+/**
+ * The number of bytes of kernelMemory already allocated.
+ */
+static uint32_t kernelMemoryBreak = 0;
+
+/**
+ * The simulated global interrupt flag.
+ */
+static bool interruptsEnabled = false;
+
+/** @name Kernel */
+/** @{         */
+
+void *
+KIncrementalMalloc(const size_t size)
+{
+  const uint32_t alignedSize = ((uint32_t)size + KERNEL_MEMORY_ALIGNMENT - 1)
+    & ~(uint32_t)(KERNEL_MEMORY_ALIGNMENT - 1);
+  void *block;
+
+  if (alignedSize > sizeof(kernelMemory) - kernelMemoryBreak) {
+    return NULL;
+  }
+
+  block = ALLOW_ARITHM((void *)kernelMemory) + kernelMemoryBreak;
+  kernelMemoryBreak += alignedSize;
+
+  return block;
+}
+
+void
+Memory_Copy(const void * source, void * destination, const size_t size)
+{
+  const uint8_t *sourceBytes = (const uint8_t *)source;
+  uint8_t *destinationBytes = (uint8_t *)destination;
+  size_t i;
+
+  for (i = 0; i < size; ++i) {
+    destinationBytes[i] = sourceBytes[i];
+  }
+}
+
+void
+Kernel_Panic(void)
+{
+  Host_Abort("Kernel panic.");
+}
+
+void
+Kernel_ManageFailure(void)
+{
+  Host_Abort("Failure in a kernel function call.");
+}
+
+/** @} */
+
+/** @name Execution */
+/** @{            */
+
+void
+Arch_InfiniteLoop(void)
+{
+  Host_Abort("Infinite loop.");
+}
+
+void
+Arch_ResetSystem(void)
+{
+  Host_Abort("System reset.");
+}
+
+void
+Arch_RestoreContextAndReturnFromInterrupt(void *stackPointer)
+{
+  UNUSED(stackPointer);
+
+  Host_ReturnToSimulation();
+}
+
+void
+Arch_StartRunning(void *stackPointer, size_t offsetOfPc)
+{
+  UNUSED(stackPointer);
+  UNUSED(offsetOfPc);
+
+  Host_ReturnToSimulation();
+}
+
+void
+Arch_LoadFromProgmem(const void * source,
+                     void * destination,
+                     const size_t size)
+{
+  Memory_Copy(source, destination, size);
+}
+
+uint8_t
+Arch_LoadU8FromProgmem(const void *source)
+{
+  return *((const uint8_t *)source);
+}
+
+uint16_t
+Arch_LoadU16FromProgmem(const void *source)
+{
+  return *((const uint16_t *)source);
+}
+
+void *
+Arch_LoadPointerFromProgmem(const void *source)
+{
+  return *((void * const *)source);
+}
+
+void
+(*Arch_LoadFunctionPointerFromProgmem(const void *source))(void)
+{
+  return *((void (* const *)(void))source);
+}
+
+/** @} */
+
+/** @name Interrupts */
+/** @{             */
+
+void
+Arch_DisableInterrupts(void)
+{
+  interruptsEnabled = false;
+}
+
+void
+Arch_EnableInterrupts(void)
+{
+  interruptsEnabled = true;
+}
+
+InterruptsStatus
+Arch_DisableInterruptsGetStatus(void)
+{
+  const InterruptsStatus interruptsStatus = interruptsEnabled;
+
+  interruptsEnabled = false;
+
+  return interruptsStatus;
+}
+
+void
+Arch_RestoreInterruptsStatus(const InterruptsStatus interruptsStatus)
+{
+  interruptsEnabled = interruptsStatus;
+}
+
+bool
+Arch_AreInterruptsEnabled(void)
+{
+  return interruptsEnabled;
+}
+
+void
+Arch_RecordCriticalSectionBegin(const uint16_t location,
+                                const uint8_t interruptCode)
+{
+  UNUSED(location);
+  UNUSED(interruptCode);
+}
+
+void
+Arch_RecordCriticalSectionEnd(void)
+{
+}
+
+void
+Arch_GetLongestCriticalSection(Lz_CriticalSection * const criticalSection)
+{
+  criticalSection->duration = 0;
+  criticalSection->location = 0;
+  criticalSection->interruptCode = 0;
+}
+
+void
+Arch_ResetLongestCriticalSection(void)
+{
+}
+
+/** @} */
+
+/** @name Idle and instrumentation */
+/** @{                           */
+
+void
+Arch_InitIdleCpuMode(void)
+{
+}
+
+/*
+ * Nothing happens in a simulated task until the next clock tick, that elects
+ * the next task to run.
+ */
+void
+Arch_CpuSleep(void)
+{
+  Host_ClockTickBegin();
+  Scheduler_HandleClockTick(Scheduler_GetCurrentTask()->stackPointer);
+}
+
+void
+Arch_InitInstrumentation(void)
+{
+}
+
+void
+Arch_InstrumentTaskId(const uint8_t taskId)
+{
+  UNUSED(taskId);
+}
+
+/** @} */
+
+/** @name System timer */
+/** @{               */
+
+void
+Arch_InitSystemTimer(void)
+{
+}
+
+void
+Arch_StartSystemTimer(void)
+{
+  interruptsEnabled = true;
+}
+
+/*
+ * The clock tick happens at the end of a time slice, so the counter of a
+ * running task is always at the beginning of its time slice.
+ */
+uint16_t
+Arch_GetSystemTimerCounter(void)
+{
+  return 0;
+}
+
+uint16_t
+Arch_GetSystemTimerPeriod(void)
+{
+  return SYSTEM_TIMER_PERIOD;
+}
+
+bool
+Arch_IsSystemTimerTickPending(void)
+{
+  return false;
+}
+
+/** @} */
+
+/** @name Locks */
+/** @{        */
+
+bool
+Arch_TryAcquireLock(volatile uint8_t * const lock)
+{
+  if (*lock) {
+    return false;
+  }
+
+  *lock = 1;
+
+  return true;
+}
+
+/*
+ * On the target machine, a task spins until a clock tick elects the task that
+ * holds the spinlock. The simulated task has then nothing else to do in its
+ * time slice, and tries again in its next time slice.
+ */
+void
+Lz_Spinlock_Lock(Lz_Spinlock * const spinlock)
+{
+  if (LZ_CONFIG_CHECK_NULL_PARAMETERS_IN_SPINLOCKS && NULL == spinlock) {
+    Kernel_ManageFailure();
+  }
+
+  while (!Arch_TryAcquireLock(spinlock)) {
+    Arch_CpuSleep();
+  }
+}
+
+/** @} */
+
+/** @name Arithmetic */
+/** @{               */
+
+U16DivisionResult
+Arch_Divide_U16(uint16_t numerator, uint16_t denominator)
+{
+  U16DivisionResult result = { 0, 0 };
+
+  if (0 != denominator) {
+    result.quotient = numerator / denominator;
+    result.remainder = numerator % denominator;
+  }
+
+  return result;
+}
+
+U32DivisionResult
+Arch_Divide_U32(uint32_t numerator, uint32_t denominator)
+{
+  U32DivisionResult result;
+
+  if (0 == denominator) {
+    Kernel_ManageFailure();
+  }
+
+  result.quotient = numerator / denominator;
+  result.remainder = numerator % denominator;
+
+  return result;
+}
+
+uint32_t
+Arch_Multiply_U32(uint32_t a, uint32_t b)
+{
+  return a * b;
+}
+
+/** @} */
@@ -0,0 +1,1265 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Simulated tasks for the host build.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file builds a synthetic set of tasks, and simulates their behaviour
+ * time slice per time slice.
+ *
+ * A simulated task never runs its entry point. Instead, each time slice given
+ * to a task runs its behaviour from the beginning: the behaviour either
+ * computes for the whole time slice, or calls a blocking function of the
+ * kernel. A blocking call never returns: the clock tick elects the next task
+ * and the host program runs its time slice. So a task blocked on a mutex calls
+ * Lz_Mutex_Lock() again in its next time slice, exactly like the loop of
+ * Lz_Mutex_Lock() does on the target machine.
+ *
+ * The behaviours are:
+ * - Timer tasks, that compute for a few time slices, then wait for a software
+ *   timer.
+ * - Interrupt tasks, that wait for an interrupt, then compute for a few time
+ *   slices. Interrupts are raised at random.
+ * - Mutex tasks, that lock a mutex shared with other tasks, compute for a few
+ *   time slices, unlock the mutex, then wait for a software timer.
+ * - Cyclic tasks, whose jobs last less than one time slice. Their release
+ *   offsets are random, or chosen by the kernel.
+ * - If task budgets are enabled, a hog task of the highest priority, that
+ *   computes forever, and is only kept from starving the other tasks by its
+ *   CPU budget.
+ * - Cooperative tasks, that compute for a few time slices, yield, compute for
+ *   a few more time slices, then wait for a software timer.
+ * - If basic tasks are enabled, basic tasks that compute for a few time slices
+ *   each time they are activated, periodically, by an interrupt or by a timer
+ *   task when it waits. The task running basic tasks is not simulated by a
+ *   behaviour: its time slices run the basic tasks of the current level of its
+ *   stack, as BasicTasksDispatcher() does on the target machine.
+ *
+ * The simulation knows when each waiting task must become ready, and measures
+ * the latency between this clock tick and the clock tick that elects the task.
+ * It also checks that the scheduler never elects a task too early, never holds
+ * a mutex twice, never elects the idle task while a task is ready, never
+ * preempts a priority task before the end of its quantum, but for a task of
+ * higher priority or a cyclic task, and never preempts a cooperative task but
+ * for a real-time task. The hog task waits for the replenishment
+ * of its budget, so running beyond its budget is electing it too early.
+ * Basic tasks must start by order of priority, be preempted only by a basic
+ * task of higher priority, and keep tasks of lower priority from running while
+ * they are activated or running.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/basic_task.h>
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/mutex.h>
+
+#include <Lazuli/sys/arch/AVR/interrupts.h>
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/scheduler.h>
+#include <Lazuli/sys/task.h>
+
+#include "host.h"
+
+DEPENDENCY_ON_MODULE(MUTEX);
+
+/**
+ * The number of mutexes shared by the mutex tasks.
+ */
+#define MUTEXES_COUNT (4)
+
+/**
+ * The value of SimulatedTask.readyTick while the event a task waits for has
+ * not happened yet.
+ */
+#define NEVER (UINT32_MAX)
+
+/**
+ * The value of SimulatedMutex.owner when the mutex is unlocked.
+ */
+#define NO_OWNER (UINT8_MAX)
+
+/**
+ * The share of the CPU the timer and mutex tasks are built to use, in percent.
+ */
+#define TARGET_CPU_USAGE (70)
+
+/**
+ * The CPU budget of the hog task, in time slices per HOG_PERIOD.
+ */
+#define HOG_BUDGET (2)
+
+/**
+ * The period of replenishment of the budget of the hog task.
+ */
+#define HOG_PERIOD (20)
+
+/**
+ * The priority of the hog task, higher than the one of all other tasks.
+ */
+#define HOG_PRIORITY (-9)
+
+/**
+ * The number of basic tasks.
+ */
+#define BASIC_TASKS_COUNT (6)
+
+/**
+ * A priority lower than the one of all basic tasks.
+ */
+#define NO_BASIC_TASK_PRIORITY (INT8_MAX + 1)
+
+/**
+ * The behaviour of a simulated task.
+ */
+enum Behaviour {
+  BEHAVIOUR_TIMER       = 0, /**< Computes, then waits for a software timer */
+  BEHAVIOUR_INTERRUPT   = 1, /**< Waits for an interrupt, then computes     */
+  BEHAVIOUR_MUTEX       = 2, /**< Computes with a mutex locked, then waits  */
+  BEHAVIOUR_CYCLIC      = 3, /**< Cyclic real-time task                     */
+  BEHAVIOUR_HOG         = 4, /**< Computes forever, throttled by its budget */
+  BEHAVIOUR_COOPERATIVE = 5  /**< Computes, yields, computes, then waits    */
+};
+
+/**
+ * The event a simulated task waits for.
+ */
+enum WaitedEvent {
+  WAITED_EVENT_NONE       = 0, /**< The task is ready            */
+  WAITED_EVENT_TIMER      = 1, /**< A software timer expiration  */
+  WAITED_EVENT_INTERRUPT  = 2, /**< An interrupt                 */
+  WAITED_EVENT_MUTEX      = 3, /**< The unlocking of a mutex     */
+  WAITED_EVENT_ACTIVATION = 4, /**< The release of a cyclic job  */
+  WAITED_EVENT_BUDGET     = 5  /**< The replenishment of budget  */
+};
+
+/**
+ * The state of a simulated task.
+ */
+typedef struct {
+  /** The behaviour of the task, from enum Behaviour */
+  uint8_t behaviour;
+
+  /** The event the task waits for, from enum WaitedEvent */
+  uint8_t waitedEvent;
+
+  /** The interrupt code waited by an interrupt task */
+  uint8_t interruptCode;
+
+  /** The index of the mutex used by a mutex task */
+  uint8_t mutexIndex;
+
+  /** The index of the basic task a timer task activates, or NO_OWNER */
+  uint8_t basicTaskIndex;
+
+  /** Indicates that a mutex task has locked its mutex */
+  bool isHoldingMutex;
+
+  /** Indicates that a cooperative task has yielded in its current job */
+  bool hasYielded;
+
+  /** The number of time slices a job computes for */
+  uint16_t workSlices;
+
+  /** The number of time slices the current job still has to compute for */
+  uint16_t remainingSlices;
+
+  /** The duration of the software timer waited by the task */
+  lz_u_resolution_unit_t sleepTicks;
+
+  /** The clock tick at which the waited event makes the task ready */
+  uint32_t readyTick;
+
+  /** The clock tick at which the budget of the hog task is replenished */
+  uint32_t replenishmentTick;
+
+  /** The priority of the task */
+  lz_task_priority_t priority;
+
+  /** The quantum of the task, in time slices */
+  uint8_t quantum;
+
+  /** The number of time slices until the quantum of the task expires */
+  uint8_t quantumLeft;
+}SimulatedTask;
+
+/**
+ * A mutex shared by mutex tasks.
+ */
+typedef struct {
+  /** The mutex */
+  Lz_Mutex mutex;
+
+  /** The ID of the task holding the mutex, or NO_OWNER */
+  uint8_t owner;
+}SimulatedMutex;
+
+/**
+ * The state of a simulated basic task.
+ */
+typedef struct {
+  /** The basic task */
+  Lz_BasicTask basicTask;
+
+  /** The priority of the basic task */
+  lz_task_priority_t priority;
+
+  /** The period of activation of the basic task, or 0 */
+  lz_u_resolution_unit_t period;
+
+  /** The interrupt code activating the basic task, or 0 */
+  uint8_t interruptCode;
+
+  /** Indicates that the basic task is activated and not started yet */
+  bool isPending;
+
+  /** The number of time slices a job computes for */
+  uint16_t workSlices;
+
+  /** The number of time slices the current job still has to compute for */
+  uint16_t remainingSlices;
+}SimulatedBasicTask;
+
+/**
+ * The simulated tasks, indexed by task ID.
+ */
+static SimulatedTask simulatedTasks[SIMULATION_MAX_TASKS];
+
+/**
+ * The mutexes shared by the mutex tasks.
+ */
+static SimulatedMutex simulatedMutexes[MUTEXES_COUNT];
+
+/**
+ * The number of simulated tasks, the idle task excluded.
+ */
+static uint8_t simulatedTasksCount = 0;
+
+/**
+ * The simulated basic tasks.
+ */
+static SimulatedBasicTask simulatedBasicTasks[BASIC_TASKS_COUNT];
+
+/**
+ * The number of simulated basic tasks.
+ */
+static uint8_t simulatedBasicTasksCount = 0;
+
+/**
+ * The basic task running on each level of the stack of basic tasks, or NULL
+ * where the level looks for a basic task to start.
+ */
+static SimulatedBasicTask *basicTasksLevels[BASIC_TASKS_COUNT + 1];
+
+/**
+ * The number of levels of the stack of basic tasks.
+ */
+static uint8_t basicTasksLevelsCount = 1;
+
+/**
+ * The ID of the task running basic tasks, or NO_OWNER.
+ */
+static uint8_t basicTasksExecutiveId = NO_OWNER;
+
+/**
+ * An interrupt is raised, on average, once every interruptPeriod time slices.
+ */
+static uint16_t interruptPeriod;
+
+/**
+ * The state of the pseudo-random generator.
+ */
+static uint32_t randomState;
+
+/**
+ * The ID of the task that ran the last time slice.
+ */
+static uint8_t lastTaskId = NO_OWNER;
+
+/**
+ * The ID of the task that computed for the whole last time slice, if it is a
+ * cooperative task or a priority task with some quantum left, or NO_OWNER.
+ */
+static uint8_t computingTaskId = NO_OWNER;
+
+/**
+ * The results of the simulation.
+ */
+static SimulationResults results;
+
+/**
+ * Get the next pseudo-random number (xorshift32).
+ *
+ * @return A pseudo-random number.
+ */
+static uint32_t
+Random(void)
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+
+  return randomState;
+}
+
+/**
+ * Get a pseudo-random number in a given range.
+ *
+ * @param min The lowest number of the range.
+ * @param max The highest number of the range.
+ *
+ * @return A pseudo-random number between min and max, both included.
+ */
+static uint32_t
+RandomInRange(const uint32_t min, const uint32_t max)
+{
+  return min + Random() % (max - min + 1);
+}
+
+/**
+ * The entry point of all simulated tasks, that is never executed.
+ */
+static void
+TaskEntryPoint(void)
+{
+  Host_Abort("The entry point of a simulated task has been executed.");
+}
+
+/**
+ * Get the duration of the software timer of a task that computes for a given
+ * number of time slices, so all timer and mutex tasks use about
+ * TARGET_CPU_USAGE percent of the CPU.
+ *
+ * @param workSlices The number of time slices a job computes for.
+ *
+ * @return The duration of the software timer, in clock ticks.
+ */
+static lz_u_resolution_unit_t
+GetSleepTicks(const uint16_t workSlices)
+{
+  /* The slice in which the task waits is lost */
+  const uint32_t jobSlices = workSlices + 1;
+
+  return (lz_u_resolution_unit_t)
+    (jobSlices * simulatedTasksCount * RandomInRange(50, 236)
+     / TARGET_CPU_USAGE);
+}
+
+/**
+ * Register a simulated task.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask, whose behaviour is set.
+ *
+ * @return
+ *         - _true_ if the task has been registered.
+ *         - _false_ if the kernel failed to register the task.
+ */
+static bool
+RegisterSimulatedTask(SimulatedTask * const simulatedTask)
+{
+  Lz_TaskConfiguration taskConfiguration;
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+
+  simulatedTask->waitedEvent = WAITED_EVENT_NONE;
+  simulatedTask->basicTaskIndex = NO_OWNER;
+  simulatedTask->isHoldingMutex = false;
+  simulatedTask->hasYielded = false;
+  simulatedTask->remainingSlices = 0;
+  simulatedTask->readyTick = NEVER;
+  simulatedTask->replenishmentTick = 0;
+
+  switch (simulatedTask->behaviour) {
+  case BEHAVIOUR_TIMER:
+    simulatedTask->workSlices = (uint16_t)RandomInRange(0, 2);
+    simulatedTask->sleepTicks = GetSleepTicks(simulatedTask->workSlices);
+    taskConfiguration.name = "timer";
+
+    if (simulatedBasicTasksCount > 0 && 0 == RandomInRange(0, 3)) {
+      simulatedTask->basicTaskIndex =
+        (uint8_t)RandomInRange(0, simulatedBasicTasksCount - 1);
+    }
+    break;
+
+  case BEHAVIOUR_INTERRUPT:
+    simulatedTask->workSlices = (uint16_t)RandomInRange(0, 1);
+    simulatedTask->interruptCode = (uint8_t)RandomInRange(1, INT_LAST_ENTRY);
+    taskConfiguration.name = "interrupt";
+    break;
+
+  case BEHAVIOUR_MUTEX:
+    simulatedTask->workSlices = (uint16_t)RandomInRange(1, 2);
+    simulatedTask->sleepTicks = GetSleepTicks(simulatedTask->workSlices);
+    simulatedTask->mutexIndex = (uint8_t)RandomInRange(0, MUTEXES_COUNT - 1);
+    taskConfiguration.name = "mutex";
+    break;
+
+  case BEHAVIOUR_COOPERATIVE:
+    simulatedTask->workSlices = (uint16_t)RandomInRange(1, 3);
+    /* A job computes twice, and also loses the time slice in which it yields */
+    simulatedTask->sleepTicks =
+      GetSleepTicks(2 * simulatedTask->workSlices + 1);
+    taskConfiguration.name = "cooperative";
+    taskConfiguration.schedulingPolicy = COOPERATIVE;
+    break;
+
+  case BEHAVIOUR_HOG:
+    taskConfiguration.name = "hog";
+    taskConfiguration.period = HOG_PERIOD;
+    taskConfiguration.budget = HOG_BUDGET;
+    break;
+
+  default:
+    taskConfiguration.name = "cyclic";
+    taskConfiguration.schedulingPolicy = CYCLIC_RT;
+    taskConfiguration.period = (lz_u_resolution_unit_t)
+      RandomInRange(2 * simulatedTasksCount, 4 * simulatedTasksCount);
+    taskConfiguration.completion = 1;
+
+    if (LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS && 0 == RandomInRange(0, 1)) {
+      taskConfiguration.offset = LZ_RELEASE_OFFSET_AUTOMATIC;
+    } else {
+      taskConfiguration.offset = (lz_u_resolution_unit_t)
+        RandomInRange(0, taskConfiguration.period - 1);
+    }
+
+    /* The first release is known once the scheduler has started */
+    simulatedTask->waitedEvent = WAITED_EVENT_ACTIVATION;
+    break;
+  }
+
+  if (PRIORITY_RT == taskConfiguration.schedulingPolicy) {
+    taskConfiguration.priority =
+      (lz_task_priority_t)((int)RandomInRange(0, 15) - 8);
+  }
+
+  if (BEHAVIOUR_HOG == simulatedTask->behaviour) {
+    taskConfiguration.priority = HOG_PRIORITY;
+  }
+
+  if (PRIORITY_RT == taskConfiguration.schedulingPolicy) {
+    taskConfiguration.quantum = (uint8_t)RandomInRange(1, 4);
+  }
+
+  simulatedTask->priority = taskConfiguration.priority;
+  simulatedTask->quantum = taskConfiguration.quantum;
+  simulatedTask->quantumLeft = taskConfiguration.quantum;
+
+  return Lz_RegisterTask(TaskEntryPoint, &taskConfiguration);
+}
+
+/**
+ * Record the wake up of a task elected for the first time since it waited for
+ * an event.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask.
+ * @param now The current clock tick.
+ */
+static void
+RecordWakeup(SimulatedTask * const simulatedTask, const uint32_t now)
+{
+  uint32_t latency;
+
+  if (NEVER == simulatedTask->readyTick || now < simulatedTask->readyTick) {
+    Host_Abort("A task has been elected before the event it waits for.");
+  }
+
+  latency = now - simulatedTask->readyTick;
+
+  ++results.wakeups;
+  results.wakeupLatencySum += latency;
+
+  if (latency > results.wakeupLatencyMax) {
+    results.wakeupLatencyMax = latency;
+  }
+
+  if (0 == latency) {
+    ++results.wakeupsOnTime;
+  }
+
+  simulatedTask->waitedEvent = WAITED_EVENT_NONE;
+}
+
+/**
+ * Check that no task is ready, when the idle task is elected.
+ *
+ * @param now The current clock tick.
+ */
+static void
+CheckNoTaskReady(const uint32_t now)
+{
+  uint8_t i;
+
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    const SimulatedTask * const simulatedTask = &simulatedTasks[i];
+
+    if (WAITED_EVENT_NONE == simulatedTask->waitedEvent ||
+        (NEVER != simulatedTask->readyTick &&
+         simulatedTask->readyTick <= now)) {
+      Host_Abort("The idle task has been elected while a task is ready.");
+    }
+  }
+}
+
+/**
+ * Check that the task that computed for the whole last time slice is only
+ * preempted by a real-time task if it is a cooperative task, or by a task of
+ * higher priority or a cyclic task if it is a priority task whose quantum is
+ * not expired.
+ *
+ * @param task A pointer to the elected Task.
+ */
+static void
+CheckPreemption(const Task * const task)
+{
+  const SimulatedTask *computingTask;
+  /* The task running basic tasks is a priority task */
+  const bool isSimulatedTask = task->id < simulatedTasksCount ||
+    task->id == basicTasksExecutiveId;
+
+  if (NO_OWNER == computingTaskId || task->id == computingTaskId) {
+    return;
+  }
+
+  computingTask = &simulatedTasks[computingTaskId];
+
+  if (BEHAVIOUR_COOPERATIVE == computingTask->behaviour) {
+    if (isSimulatedTask && COOPERATIVE != task->schedulingPolicy) {
+      return;
+    }
+
+    Host_Abort("A cooperative task has been preempted by a task that is not"
+               " real-time.");
+  }
+
+  if (isSimulatedTask &&
+      (CYCLIC_RT == task->schedulingPolicy ||
+       (PRIORITY_RT == task->schedulingPolicy &&
+        task->priority < computingTask->priority))) {
+    return;
+  }
+
+  Host_Abort("A task has been preempted before the end of its quantum.");
+}
+
+/**
+ * The entry point of all simulated basic tasks, that is never executed.
+ */
+static void
+BasicTaskEntryPoint(void)
+{
+  Host_Abort("The entry point of a simulated basic task has been executed.");
+}
+
+/**
+ * Register the simulated basic tasks: half of them are activated periodically,
+ * a quarter by an interrupt, and a quarter by timer tasks.
+ *
+ * @return
+ *         - _true_ if the basic tasks have been registered.
+ *         - _false_ if the kernel failed to register a basic task.
+ */
+static bool
+RegisterSimulatedBasicTasks(void)
+{
+  Lz_BasicTaskConfiguration configuration;
+  uint8_t i;
+
+  for (i = 0; i < BASIC_TASKS_COUNT; ++i) {
+    SimulatedBasicTask * const simulatedBasicTask = &simulatedBasicTasks[i];
+    const uint32_t draw = RandomInRange(0, 3);
+
+    configuration.priority =
+      (lz_task_priority_t)((int)RandomInRange(0, 15) - 8);
+    configuration.period = 0;
+    configuration.interruptCode = 0;
+
+    if (draw < 2) {
+      configuration.period = (lz_u_resolution_unit_t)RandomInRange(10, 60);
+    } else if (draw < 3) {
+      configuration.interruptCode = (uint8_t)RandomInRange(1, INT_LAST_ENTRY);
+    }
+
+    simulatedBasicTask->priority = configuration.priority;
+    simulatedBasicTask->period = configuration.period;
+    simulatedBasicTask->interruptCode = configuration.interruptCode;
+    simulatedBasicTask->isPending = false;
+    simulatedBasicTask->workSlices = (uint16_t)RandomInRange(0, 2);
+    simulatedBasicTask->remainingSlices = 0;
+
+    if (!Lz_RegisterBasicTask(&simulatedBasicTask->basicTask,
+                              BasicTaskEntryPoint,
+                              &configuration)) {
+      return false;
+    }
+  }
+
+  simulatedBasicTasksCount = BASIC_TASKS_COUNT;
+
+  /* The task running basic tasks is registered by Lz_Run(), before idle */
+  basicTasksExecutiveId = simulatedTasksCount;
+
+  return true;
+}
+
+/**
+ * Get the highest priority of the activated basic tasks.
+ *
+ * @return The highest priority, or NO_BASIC_TASK_PRIORITY if no basic task is
+ *         activated.
+ */
+static int
+GetPendingBasicTasksPriority(void)
+{
+  int priority = NO_BASIC_TASK_PRIORITY;
+  uint8_t i;
+
+  for (i = 0; i < simulatedBasicTasksCount; ++i) {
+    if (simulatedBasicTasks[i].isPending &&
+        simulatedBasicTasks[i].priority < priority) {
+      priority = simulatedBasicTasks[i].priority;
+    }
+  }
+
+  return priority;
+}
+
+/**
+ * Get the running basic task, i.e. the one of the highest level of the stack
+ * of basic tasks on which a basic task runs.
+ *
+ * @return A pointer to the running SimulatedBasicTask, or NULL.
+ */
+static SimulatedBasicTask *
+GetRunningBasicTask(void)
+{
+  uint8_t i;
+
+  for (i = basicTasksLevelsCount; i > 0; --i) {
+    if (NULL != basicTasksLevels[i - 1]) {
+      return basicTasksLevels[i - 1];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Get the priority of the task running basic tasks, i.e. the highest priority
+ * of the activated and running basic tasks.
+ *
+ * @return The priority, or NO_BASIC_TASK_PRIORITY if no basic task is
+ *         activated or running.
+ */
+static int
+GetBasicTasksPriority(void)
+{
+  const SimulatedBasicTask * const runningBasicTask = GetRunningBasicTask();
+  const int priority = GetPendingBasicTasksPriority();
+
+  if (NULL != runningBasicTask && runningBasicTask->priority < priority) {
+    return runningBasicTask->priority;
+  }
+
+  return priority;
+}
+
+/**
+ * Mark as activated a simulated basic task, after the kernel activated it. An
+ * activation of a basic task already activated is lost.
+ *
+ * @param simulatedBasicTask A pointer to the SimulatedBasicTask.
+ */
+static void
+ActivateSimulatedBasicTask(SimulatedBasicTask * const simulatedBasicTask)
+{
+  simulatedBasicTask->isPending = true;
+}
+
+/**
+ * Activate the periodic basic tasks, at the clock ticks k * period.
+ *
+ * @param now The current clock tick.
+ */
+static void
+ActivatePeriodicBasicTasks(const uint32_t now)
+{
+  uint8_t i;
+
+  for (i = 0; i < simulatedBasicTasksCount; ++i) {
+    SimulatedBasicTask * const simulatedBasicTask = &simulatedBasicTasks[i];
+
+    if (0 != simulatedBasicTask->period &&
+        0 == now % simulatedBasicTask->period) {
+      ActivateSimulatedBasicTask(simulatedBasicTask);
+    }
+  }
+}
+
+/**
+ * Activate the basic task of a timer task, if any, and check that the kernel
+ * only loses the activation if the basic task is already activated.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ */
+static void
+ActivateBasicTaskOfTask(const SimulatedTask * const simulatedTask)
+{
+  SimulatedBasicTask *simulatedBasicTask;
+
+  if (NO_OWNER == simulatedTask->basicTaskIndex) {
+    return;
+  }
+
+  simulatedBasicTask = &simulatedBasicTasks[simulatedTask->basicTaskIndex];
+
+  if (Lz_BasicTask_Activate(&simulatedBasicTask->basicTask) ==
+      simulatedBasicTask->isPending) {
+    Host_Abort("The activation of a basic task has been lost or doubled.");
+  }
+
+  ActivateSimulatedBasicTask(simulatedBasicTask);
+}
+
+/**
+ * Follow the levels pushed and popped by the kernel on the stack of basic
+ * tasks since the last time slice of the task running basic tasks.
+ */
+static void
+FollowBasicTasksNesting(void)
+{
+  const uint8_t levelsCount = Scheduler_GetBasicTasksNestingLevel() + 1;
+
+  if (levelsCount > basicTasksLevelsCount) {
+    if (NULL == basicTasksLevels[basicTasksLevelsCount - 1] ||
+        basicTasksLevelsCount >= ELEMENTS_COUNT(basicTasksLevels)) {
+      Host_Abort("A basic task has been preempted while none runs.");
+    }
+
+    basicTasksLevels[basicTasksLevelsCount++] = NULL;
+  } else if (levelsCount < basicTasksLevelsCount) {
+    if (NULL != basicTasksLevels[basicTasksLevelsCount - 1]) {
+      Host_Abort("A level of basic tasks has ended while a basic task runs.");
+    }
+
+    --basicTasksLevelsCount;
+  }
+
+  if (levelsCount != basicTasksLevelsCount) {
+    Host_Abort("The nesting of basic tasks is wrong.");
+  }
+}
+
+/**
+ * Check the basic tasks at the beginning of a time slice, before the
+ * interrupts of the time slice: the running basic task must have been
+ * preempted by an activated basic task of higher priority, and a task must not
+ * be elected while a basic task of higher priority is activated or running.
+ *
+ * @param task A pointer to the elected Task.
+ */
+static void
+CheckBasicTasks(const Task * const task)
+{
+  const SimulatedBasicTask *runningBasicTask;
+  const bool isIdleTask = task->id >= simulatedTasksCount;
+
+  if (task->id == basicTasksExecutiveId) {
+    FollowBasicTasksNesting();
+    runningBasicTask = basicTasksLevels[basicTasksLevelsCount - 1];
+
+    if (NULL != runningBasicTask &&
+        GetPendingBasicTasksPriority() < runningBasicTask->priority) {
+      Host_Abort("A basic task has not been preempted by an activated basic"
+                 " task of higher priority.");
+    }
+  } else if (isIdleTask || COOPERATIVE == task->schedulingPolicy ||
+             (PRIORITY_RT == task->schedulingPolicy &&
+              GetBasicTasksPriority() < task->priority)) {
+    if (NO_BASIC_TASK_PRIORITY != GetBasicTasksPriority()) {
+      Host_Abort("A task has been elected while a basic task of higher"
+                 " priority is ready.");
+    }
+  }
+}
+
+/**
+ * Check a basic task started by the kernel on the current level of the stack
+ * of basic tasks.
+ *
+ * @param simulatedBasicTask A pointer to the started SimulatedBasicTask, or
+ *                           NULL if no basic task has been started.
+ */
+static void
+CheckStartedBasicTask(const SimulatedBasicTask * const simulatedBasicTask)
+{
+  const SimulatedBasicTask * const preemptedBasicTask = GetRunningBasicTask();
+  const int preemptedPriority = NULL == preemptedBasicTask ?
+    NO_BASIC_TASK_PRIORITY : preemptedBasicTask->priority;
+  const int pendingPriority = GetPendingBasicTasksPriority();
+
+  if (NULL == simulatedBasicTask) {
+    if (pendingPriority < preemptedPriority) {
+      Host_Abort("An activated basic task of higher priority has not been"
+                 " started.");
+    }
+
+    return;
+  }
+
+  if (!simulatedBasicTask->isPending) {
+    Host_Abort("A basic task has been started without being activated.");
+  }
+
+  if (simulatedBasicTask->priority >= preemptedPriority ||
+      simulatedBasicTask->priority > pendingPriority) {
+    Host_Abort("A basic task has been started before a basic task of higher"
+               " priority.");
+  }
+}
+
+/**
+ * Run a time slice of the task running basic tasks, as BasicTasksDispatcher()
+ * does on the target machine: the basic task of the current level computes,
+ * and when it ends, the next activated basic task starts.
+ *
+ * This function returns if a basic task computes until the end of the time
+ * slice.
+ */
+static void
+RunBasicTasks(void)
+{
+  SimulatedBasicTask ** const level
+    = &basicTasksLevels[basicTasksLevelsCount - 1];
+  SimulatedBasicTask *simulatedBasicTask;
+  Lz_BasicTask *basicTask;
+
+  for (;;) {
+    if (NULL == *level) {
+      basicTask = Scheduler_StartBasicTask();
+      simulatedBasicTask = NULL == basicTask ?
+        NULL : CONTAINER_OF(basicTask, basicTask, SimulatedBasicTask);
+      CheckStartedBasicTask(simulatedBasicTask);
+
+      if (NULL == simulatedBasicTask) {
+        Scheduler_GetCurrentTask()->taskToSchedulerMessage = END_BASIC_TASKS;
+        Scheduler_SleepUntilEndOfTimeSlice();
+      }
+
+      simulatedBasicTask->isPending = false;
+      simulatedBasicTask->remainingSlices = simulatedBasicTask->workSlices;
+      *level = simulatedBasicTask;
+    }
+
+    if ((*level)->remainingSlices > 0) {
+      --(*level)->remainingSlices;
+
+      return;
+    }
+
+    Scheduler_EndBasicTask();
+    ++results.basicTaskJobs;
+    *level = NULL;
+  }
+}
+
+/**
+ * Make ready, at the next clock tick, the tasks waiting for a given event.
+ *
+ * @param waitedEvent The event, from enum WaitedEvent.
+ * @param parameter The interrupt code or the index of the mutex.
+ * @param now The current clock tick.
+ */
+static void
+SetWaitingTasksReady(const uint8_t waitedEvent,
+                     const uint8_t parameter,
+                     const uint32_t now)
+{
+  uint8_t i;
+
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    SimulatedTask * const simulatedTask = &simulatedTasks[i];
+
+    if (waitedEvent != simulatedTask->waitedEvent ||
+        NEVER != simulatedTask->readyTick) {
+      continue;
+    }
+
+    if ((WAITED_EVENT_INTERRUPT == waitedEvent &&
+         parameter == simulatedTask->interruptCode) ||
+        (WAITED_EVENT_MUTEX == waitedEvent &&
+         parameter == simulatedTask->mutexIndex)) {
+      simulatedTask->readyTick = now + 1;
+    }
+  }
+}
+
+/**
+ * Raise an interrupt at random, as if it happened at the beginning of the
+ * current time slice.
+ *
+ * @param now The current clock tick.
+ */
+static void
+RaiseRandomInterrupt(const uint32_t now)
+{
+  uint8_t interruptCode;
+  uint8_t i;
+
+  if (0 != Random() % interruptPeriod) {
+    return;
+  }
+
+  interruptCode = (uint8_t)RandomInRange(1, INT_LAST_ENTRY);
+
+  Scheduler_HandleInterrupt(interruptCode);
+  SetWaitingTasksReady(WAITED_EVENT_INTERRUPT, interruptCode, now);
+
+  for (i = 0; i < simulatedBasicTasksCount; ++i) {
+    if (interruptCode == simulatedBasicTasks[i].interruptCode) {
+      ActivateSimulatedBasicTask(&simulatedBasicTasks[i]);
+    }
+  }
+}
+
+/**
+ * Wait for the software timer of a task.
+ *
+ * This function never returns.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ * @param now The current clock tick.
+ */
+static void
+WaitTimer(SimulatedTask * const simulatedTask, const uint32_t now)
+{
+  simulatedTask->waitedEvent = WAITED_EVENT_TIMER;
+
+  /* The timer starts at the end of the current time slice */
+  simulatedTask->readyTick = now + 1 + simulatedTask->sleepTicks;
+
+  Lz_WaitTimer(simulatedTask->sleepTicks);
+}
+
+/**
+ * Wait for the release of the next job of a cyclic task.
+ *
+ * This function never returns.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ * @param now The current clock tick.
+ */
+static void
+WaitActivation(SimulatedTask * const simulatedTask, const uint32_t now)
+{
+  const Task * const task = Scheduler_GetCurrentTask();
+
+  /* Jobs are released at the clock ticks offset + k * period */
+  simulatedTask->waitedEvent = WAITED_EVENT_ACTIVATION;
+  simulatedTask->readyTick = task->offset
+    + ((now - task->offset) / task->period + 1) * task->period;
+
+  Lz_Task_WaitActivation();
+}
+
+/**
+ * Compute for a time slice of the hog task, and wait for the replenishment of
+ * its budget once it is consumed.
+ *
+ * Budgets are replenished at the clock ticks k * HOG_PERIOD.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the hog task.
+ * @param now The current clock tick.
+ */
+static void
+ConsumeBudget(SimulatedTask * const simulatedTask, const uint32_t now)
+{
+  if (now >= simulatedTask->replenishmentTick) {
+    simulatedTask->remainingSlices = HOG_BUDGET;
+    simulatedTask->replenishmentTick = (now / HOG_PERIOD + 1) * HOG_PERIOD;
+  }
+
+  --simulatedTask->remainingSlices;
+
+  if (0 == simulatedTask->remainingSlices) {
+    simulatedTask->waitedEvent = WAITED_EVENT_BUDGET;
+    simulatedTask->readyTick = simulatedTask->replenishmentTick;
+  }
+}
+
+/**
+ * Lock the mutex of a mutex task.
+ *
+ * This function returns only if the mutex has been locked.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ * @param taskId The ID of the current task.
+ */
+static void
+LockMutex(SimulatedTask * const simulatedTask, const uint8_t taskId)
+{
+  SimulatedMutex * const simulatedMutex
+    = &simulatedMutexes[simulatedTask->mutexIndex];
+
+  if (NO_OWNER != simulatedMutex->owner) {
+    ++results.mutexContentions;
+    simulatedTask->waitedEvent = WAITED_EVENT_MUTEX;
+    simulatedTask->readyTick = NEVER;
+  }
+
+  Lz_Mutex_Lock(&simulatedMutex->mutex);
+
+  if (NO_OWNER != simulatedMutex->owner) {
+    Host_Abort("A mutex has been locked by two tasks.");
+  }
+
+  simulatedMutex->owner = taskId;
+  simulatedTask->waitedEvent = WAITED_EVENT_NONE;
+  simulatedTask->isHoldingMutex = true;
+}
+
+/**
+ * Unlock the mutex of a mutex task.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ * @param now The current clock tick.
+ */
+static void
+UnlockMutex(SimulatedTask * const simulatedTask, const uint32_t now)
+{
+  SimulatedMutex * const simulatedMutex
+    = &simulatedMutexes[simulatedTask->mutexIndex];
+
+  simulatedMutex->owner = NO_OWNER;
+  simulatedTask->isHoldingMutex = false;
+
+  SetWaitingTasksReady(WAITED_EVENT_MUTEX, simulatedTask->mutexIndex, now);
+  Lz_Mutex_Unlock(&simulatedMutex->mutex);
+}
+
+/**
+ * Run the behaviour of a task for the current time slice.
+ *
+ * This function returns if the task computes until the end of its time slice.
+ *
+ * @param simulatedTask A pointer to the SimulatedTask of the current task.
+ * @param taskId The ID of the current task.
+ * @param now The current clock tick.
+ */
+static void
+RunBehaviour(SimulatedTask * const simulatedTask,
+             const uint8_t taskId,
+             const uint32_t now)
+{
+  switch (simulatedTask->behaviour) {
+  case BEHAVIOUR_TIMER:
+    if (0 == simulatedTask->remainingSlices) {
+      simulatedTask->remainingSlices = simulatedTask->workSlices;
+      ActivateBasicTaskOfTask(simulatedTask);
+      WaitTimer(simulatedTask, now);
+    }
+
+    --simulatedTask->remainingSlices;
+    break;
+
+  case BEHAVIOUR_INTERRUPT:
+    if (0 == simulatedTask->remainingSlices) {
+      simulatedTask->remainingSlices = simulatedTask->workSlices;
+      simulatedTask->waitedEvent = WAITED_EVENT_INTERRUPT;
+      simulatedTask->readyTick = NEVER;
+      Lz_Task_WaitInterrupt(simulatedTask->interruptCode);
+    }
+
+    --simulatedTask->remainingSlices;
+    break;
+
+  case BEHAVIOUR_MUTEX:
+    if (!simulatedTask->isHoldingMutex) {
+      LockMutex(simulatedTask, taskId);
+
+      /* The time slice in which the mutex is locked is the first one */
+      simulatedTask->remainingSlices = simulatedTask->workSlices;
+    }
+
+    if (0 == simulatedTask->remainingSlices) {
+      UnlockMutex(simulatedTask, now);
+      WaitTimer(simulatedTask, now);
+    }
+
+    --simulatedTask->remainingSlices;
+    break;
+
+  case BEHAVIOUR_COOPERATIVE:
+    if (0 == simulatedTask->remainingSlices) {
+      simulatedTask->remainingSlices = simulatedTask->workSlices;
+      simulatedTask->hasYielded = !simulatedTask->hasYielded;
+
+      if (simulatedTask->hasYielded) {
+        Lz_Task_Yield();
+      }
+
+      WaitTimer(simulatedTask, now);
+    }
+
+    --simulatedTask->remainingSlices;
+    break;
+
+  case BEHAVIOUR_HOG:
+    ConsumeBudget(simulatedTask, now);
+    break;
+
+  default:
+    ++results.cyclicJobs;
+    WaitActivation(simulatedTask, now);
+    break;
+  }
+}
+
+/** @name Kernel side */
+/** @{              */
+
+int
+Simulation_Init(unsigned int tasksCount, unsigned long seed)
+{
+  uint8_t i;
+
+  if (0 == tasksCount || tasksCount > SIMULATION_MAX_TASKS) {
+    return 0;
+  }
+
+  simulatedTasksCount = (uint8_t)tasksCount;
+  interruptPeriod = simulatedTasksCount / 4 + 1;
+  randomState = (uint32_t)seed;
+
+  /* xorshift32 never leaves the state 0 */
+  if (0 == randomState) {
+    randomState = 1;
+  }
+
+  for (i = 0; i < MUTEXES_COUNT; ++i) {
+    Lz_Mutex_Init(&simulatedMutexes[i].mutex);
+    simulatedMutexes[i].owner = NO_OWNER;
+  }
+
+  /* The task running basic tasks needs one more task ID */
+  if (LZ_CONFIG_BASIC_TASKS && simulatedTasksCount < SIMULATION_MAX_TASKS &&
+      !RegisterSimulatedBasicTasks()) {
+    return 0;
+  }
+
+  /*
+   * 50% of timer tasks, 10% of cooperative tasks, 15% of interrupt tasks, 15%
+   * of mutex tasks
+   */
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    const uint32_t draw = RandomInRange(0, 99);
+
+    if (draw < 50) {
+      simulatedTasks[i].behaviour = BEHAVIOUR_TIMER;
+    } else if (draw < 60) {
+      simulatedTasks[i].behaviour = BEHAVIOUR_COOPERATIVE;
+    } else if (draw < 75) {
+      simulatedTasks[i].behaviour = BEHAVIOUR_INTERRUPT;
+    } else if (draw < 90) {
+      simulatedTasks[i].behaviour = BEHAVIOUR_MUTEX;
+    } else {
+      simulatedTasks[i].behaviour = BEHAVIOUR_CYCLIC;
+    }
+
+    if (LZ_CONFIG_TASK_BUDGETS && 0 == i) {
+      simulatedTasks[i].behaviour = BEHAVIOUR_HOG;
+    }
+
+    if (!RegisterSimulatedTask(&simulatedTasks[i])) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+void
+Simulation_Start(void)
+{
+  Lz_Run();
+}
+
+void
+Simulation_RunTimeSlice(void)
+{
+  const Task * const task = Scheduler_GetCurrentTask();
+  const uint32_t now = (uint32_t)results.ticks++;
+  uint8_t quantumLeft;
+
+  if (task->id != lastTaskId) {
+    ++results.contextSwitches;
+    lastTaskId = task->id;
+  }
+
+  if (0 != simulatedBasicTasksCount) {
+    ActivatePeriodicBasicTasks(now);
+    CheckBasicTasks(task);
+  }
+
+  RaiseRandomInterrupt(now);
+
+  if (task->id == basicTasksExecutiveId) {
+    CheckPreemption(task);
+    computingTaskId = NO_OWNER;
+    RunBasicTasks();
+  } else if (task->id >= simulatedTasksCount) {
+    /* The idle task */
+    CheckPreemption(task);
+    computingTaskId = NO_OWNER;
+    CheckNoTaskReady(now);
+    ++results.idleTicks;
+  } else {
+    SimulatedTask * const simulatedTask = &simulatedTasks[task->id];
+
+    if (WAITED_EVENT_ACTIVATION == simulatedTask->waitedEvent &&
+        NEVER == simulatedTask->readyTick) {
+      /* The first job, whose offset may have been chosen by Lz_Run() */
+      simulatedTask->readyTick = task->offset;
+    }
+
+    CheckPreemption(task);
+    computingTaskId = NO_OWNER;
+
+    if (WAITED_EVENT_NONE != simulatedTask->waitedEvent) {
+      RecordWakeup(simulatedTask, now);
+    }
+
+    /* The quantum starts again if the task doesn't compute until the end */
+    quantumLeft = simulatedTask->quantumLeft;
+    simulatedTask->quantumLeft = simulatedTask->quantum;
+
+    RunBehaviour(simulatedTask, task->id, now);
+
+    if (BEHAVIOUR_COOPERATIVE == simulatedTask->behaviour) {
+      /* The task keeps the processor until it yields or waits */
+      computingTaskId = task->id;
+    } else if (BEHAVIOUR_CYCLIC != simulatedTask->behaviour &&
+               WAITED_EVENT_NONE == simulatedTask->waitedEvent &&
+               quantumLeft > 1) {
+      simulatedTask->quantumLeft = quantumLeft - 1;
+      computingTaskId = task->id;
+    }
+  }
+
+  /* Nothing else happens until the end of the time slice */
+  Arch_CpuSleep();
+}
+
+void
+Simulation_GetResults(SimulationResults *simulationResults)
+{
+  *simulationResults = results;
+}
+
+/** @} */
@@ -0,0 +1,351 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Host program driving the simulation of the scheduler.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This program runs the scheduler of Lazuli on the host, with a synthetic set
+ * of tasks, for a given number of clock ticks. It measures the duration of
+ * each clock tick on the host, and prints it along with the results measured
+ * by the simulation.
+ *
+ * This file belongs to the host side, see host.h.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host.h"
+
+/**
+ * The default number of simulated tasks.
+ */
+#define DEFAULT_TASKS_COUNT (100)
+
+/**
+ * The default number of simulated clock ticks.
+ */
+#define DEFAULT_TICKS_COUNT (1000000UL)
+
+/**
+ * The default seed of the simulation.
+ */
+#define DEFAULT_SEED (1UL)
+
+/**
+ * The width of a bucket of the histogram of clock tick durations, in
+ * nanoseconds.
+ */
+#define HISTOGRAM_BUCKET_WIDTH (10UL)
+
+/**
+ * The number of buckets of the histogram of clock tick durations. The last
+ * bucket holds all the longer durations.
+ */
+#define HISTOGRAM_BUCKETS_COUNT (10000UL)
+
+/**
+ * Where the simulated architecture layer returns after each clock tick.
+ */
+static jmp_buf simulationLoop;
+
+/**
+ * Indicates that a clock tick is being measured.
+ */
+static int isInClockTick = 0;
+
+/**
+ * The time at which the current clock tick began.
+ */
+static struct timespec clockTickBegin;
+
+/**
+ * The sum of the durations of all clock ticks, in nanoseconds.
+ */
+static unsigned long clockTicksDurationSum = 0;
+
+/**
+ * The longest clock tick, in nanoseconds.
+ */
+static unsigned long clockTickDurationMax = 0;
+
+/**
+ * The number of clock ticks measured.
+ */
+static unsigned long clockTicksCount = 0;
+
+/**
+ * The histogram of the durations of clock ticks.
+ */
+static unsigned long clockTicksHistogram[HISTOGRAM_BUCKETS_COUNT];
+
+/**
+ * Get the number of nanoseconds elapsed between two times.
+ *
+ * @param begin The earliest time.
+ * @param end The latest time.
+ *
+ * @return The number of nanoseconds elapsed.
+ */
+static unsigned long
+Elapsed(const struct timespec *begin, const struct timespec *end)
+{
+  return (unsigned long)(end->tv_sec - begin->tv_sec) * 1000000000UL
+    + (unsigned long)end->tv_nsec - (unsigned long)begin->tv_nsec;
+}
+
+/**
+ * Get a percentile of the durations of clock ticks.
+ *
+ * @param percentile The percentile, between 1 and 100.
+ *
+ * @return The upper bound of the bucket of the histogram holding the
+ *         percentile, in nanoseconds.
+ */
+static unsigned long
+GetClockTickPercentile(const unsigned long percentile)
+{
+  const unsigned long rank = (clockTicksCount * percentile + 99) / 100;
+  unsigned long count = 0;
+  unsigned long i;
+
+  for (i = 0; i < HISTOGRAM_BUCKETS_COUNT - 1; ++i) {
+    count += clockTicksHistogram[i];
+
+    if (count >= rank) {
+      break;
+    }
+  }
+
+  return (i + 1) * HISTOGRAM_BUCKET_WIDTH;
+}
+
+/**
+ * Parse a number from the command line.
+ *
+ * @param string The string to parse.
+ * @param max The highest acceptable value.
+ * @param number A pointer to the variable receiving the number.
+ *
+ * @return
+ *         - 1 if the string is a number between 0 and max.
+ *         - 0 otherwise.
+ */
+static int
+ParseNumber(const char *string, const unsigned long max, unsigned long *number)
+{
+  char *end;
+
+  errno = 0;
+  *number = strtoul(string, &end, 10);
+
+  return 0 == errno && '\0' != *string && '\0' == *end && *number <= max;
+}
+
+/**
+ * Print the usage of the program.
+ *
+ * @param programName The name of the program.
+ */
+static void
+PrintUsage(const char *programName)
+{
+  fprintf(stderr,
+          "Usage: %s [-t TASKS] [-n TICKS] [-s SEED]\n"
+          "  -t TASKS  The number of tasks, from 1 to %d (default: %d).\n"
+          "  -n TICKS  The number of clock ticks (default: %lu).\n"
+          "  -s SEED   The seed of the set of tasks (default: %lu).\n",
+          programName,
+          SIMULATION_MAX_TASKS,
+          DEFAULT_TASKS_COUNT,
+          DEFAULT_TICKS_COUNT,
+          DEFAULT_SEED);
+}
+
+/**
+ * Run the simulation.
+ *
+ * @param ticksCount The number of clock ticks to simulate.
+ */
+static void
+RunSimulation(const unsigned long ticksCount)
+{
+  /* Kept out of the stack frame, that longjmp() returns to */
+  static volatile unsigned long remainingTicks;
+
+  remainingTicks = ticksCount;
+
+  if (0 == setjmp(simulationLoop)) {
+    Simulation_Start();
+  }
+
+  /* Each clock tick returns here, once it has elected the next task */
+  if (remainingTicks > 0) {
+    --remainingTicks;
+    Simulation_RunTimeSlice();
+  }
+}
+
+/**
+ * Print the results of the simulation.
+ *
+ * @param tasksCount The number of simulated tasks.
+ * @param seed The seed of the simulation.
+ * @param duration The duration of the whole simulation on the host, in
+ *                 nanoseconds.
+ */
+static void
+PrintResults(const unsigned long tasksCount,
+             const unsigned long seed,
+             const unsigned long duration)
+{
+  SimulationResults results;
+  unsigned long ticks;
+
+  Simulation_GetResults(&results);
+
+  /* Avoid divisions by zero */
+  ticks = results.ticks > 0 ? results.ticks : 1;
+
+  printf("Tasks: %lu\n", tasksCount);
+  printf("Seed: %lu\n", seed);
+  printf("Clock ticks: %lu\n", results.ticks);
+  printf("Clock tick duration (ns): mean %lu, median %lu, 99th percentile %lu,"
+         " max %lu\n",
+         clockTicksDurationSum / (clockTicksCount > 0 ? clockTicksCount : 1),
+         GetClockTickPercentile(50),
+         GetClockTickPercentile(99),
+         clockTickDurationMax);
+  printf("Simulation duration (ns per clock tick): %lu\n", duration / ticks);
+  printf("Context switches: %lu (%lu%%)\n",
+         results.contextSwitches,
+         results.contextSwitches * 100 / ticks);
+  printf("Idle time slices: %lu (%lu%%)\n",
+         results.idleTicks,
+         results.idleTicks * 100 / ticks);
+  printf("Wake ups: %lu, on time %lu%%\n",
+         results.wakeups,
+         results.wakeupsOnTime * 100
+         / (results.wakeups > 0 ? results.wakeups : 1));
+  printf("Wake up latency (clock ticks): mean %.2f, max %lu\n",
+         (double)results.wakeupLatencySum
+         / (double)(results.wakeups > 0 ? results.wakeups : 1),
+         results.wakeupLatencyMax);
+  printf("Mutex contentions: %lu\n", results.mutexContentions);
+  printf("Cyclic jobs: %lu\n", results.cyclicJobs);
+  printf("Basic task jobs: %lu\n", results.basicTaskJobs);
+}
+
+void
+Host_ReturnToSimulation(void)
+{
+  struct timespec clockTickEnd;
+  unsigned long duration;
+
+  if (isInClockTick) {
+    clock_gettime(CLOCK_MONOTONIC, &clockTickEnd);
+    duration = Elapsed(&clockTickBegin, &clockTickEnd);
+
+    clockTicksDurationSum += duration;
+    ++clockTicksCount;
+
+    if (duration > clockTickDurationMax) {
+      clockTickDurationMax = duration;
+    }
+
+    if (duration / HISTOGRAM_BUCKET_WIDTH < HISTOGRAM_BUCKETS_COUNT) {
+      ++clockTicksHistogram[duration / HISTOGRAM_BUCKET_WIDTH];
+    } else {
+      ++clockTicksHistogram[HISTOGRAM_BUCKETS_COUNT - 1];
+    }
+
+    isInClockTick = 0;
+  }
+
+  longjmp(simulationLoop, 1);
+}
+
+void
+Host_ClockTickBegin(void)
+{
+  isInClockTick = 1;
+  clock_gettime(CLOCK_MONOTONIC, &clockTickBegin);
+}
+
+void
+Host_Abort(const char *message)
+{
+  SimulationResults results;
+
+  Simulation_GetResults(&results);
+
+  fprintf(stderr,
+          "Simulation aborted at clock tick %lu: %s\n",
+          results.ticks,
+          message);
+
+  exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned long tasksCount = DEFAULT_TASKS_COUNT;
+  unsigned long ticksCount = DEFAULT_TICKS_COUNT;
+  unsigned long seed = DEFAULT_SEED;
+  struct timespec begin;
+  struct timespec end;
+  int option;
+  int isValid = 1;
+
+  while (-1 != (option = getopt(argc, argv, "t:n:s:h"))) {
+    switch (option) {
+    case 't':
+      isValid = isValid &&
+        ParseNumber(optarg, SIMULATION_MAX_TASKS, &tasksCount) &&
+        tasksCount > 0;
+      break;
+
+    case 'n':
+      isValid = isValid && ParseNumber(optarg, ULONG_MAX, &ticksCount);
+      break;
+
+    case 's':
+      isValid = isValid && ParseNumber(optarg, ULONG_MAX, &seed);
+      break;
+
+    default:
+      isValid = 0;
+      break;
+    }
+  }
+
+  if (!isValid || optind != argc) {
+    PrintUsage(argv[0]);
+
+    return EXIT_FAILURE;
+  }
+
+  if (!Simulation_Init((unsigned int)tasksCount, seed)) {
+    fprintf(stderr, "Unable to register %lu tasks.\n", tasksCount);
+
+    return EXIT_FAILURE;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+  RunSimulation(ticksCount);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  PrintResults(tasksCount, seed, Elapsed(&begin, &end));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,389 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Simulated tasks of the time-triggered scheduler for the host build.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file runs the time-triggered scheduler with the schedule table built
+ * before compilation by sys/cmake/schedule_table.cmake, and checks that the
+ * scheduler follows it.
+ *
+ * The cyclic real-time tasks are the ones of the table: their IDs are the IDs
+ * found in the table, and their completion time is the number of slots of
+ * their jobs. Each job computes for a random number of time slices, between 0
+ * and its completion time, then calls Lz_Task_WaitActivation(). A job that
+ * computes for its whole completion time never calls it: the scheduler stops
+ * the job at the end of its last slot.
+ *
+ * One task, drawn from the seed, terminates at the beginning of a job drawn
+ * from the seed, and another one aborts the same way. The slots of a stopped
+ * task are then given to the idle task.
+ *
+ * At each time slice, the simulation reads the slot of the table itself, and
+ * stops with an error if the scheduler elected another task than the one of
+ * the slot, or than the idle task once the job has ended. It also walks the
+ * kernel snapshot, and stops with an error if the state of a task is wrong.
+ *
+ * This file belongs to the kernel side, see host.h.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/scheduler.h>
+#include <Lazuli/sys/task.h>
+
+#include "host.h"
+#include "schedule_table.h"
+
+/**
+ * The greatest number of the job a task stops at.
+ */
+#define MAX_JOBS_BEFORE_STOP 2048U
+
+/**
+ * The state of a simulated task.
+ */
+typedef struct {
+  /** The completion time of the task, in time slices */
+  uint16_t completion;
+
+  /** The number of slots the current job can still run, by the table */
+  uint16_t remainingSlots;
+
+  /** The number of time slices the current job still computes for */
+  uint16_t remainingWork;
+
+  /** Indicates that the current job called Lz_Task_WaitActivation() */
+  bool isJobEnded;
+
+  /** The number of the job the task stops at, or 0 if it never stops */
+  uint16_t jobsBeforeStop;
+
+  /** The state the task stops in */
+  lz_task_state_t stopState;
+
+  /** The state of the task in the kernel snapshot when it doesn't run */
+  lz_task_state_t state;
+}SimulatedTask;
+
+/**
+ * The simulated tasks, indexed by task ID.
+ */
+static SimulatedTask simulatedTasks[LZ_SCHEDULE_SLOT_TASK_ID_MASK];
+
+/**
+ * The number of simulated tasks, the idle task excluded.
+ */
+static uint8_t simulatedTasksCount = 0;
+
+/**
+ * The state of the pseudo-random generator.
+ */
+static uint32_t randomState;
+
+/**
+ * The ID of the task that ran the last time slice.
+ */
+static uint8_t lastTaskId = UINT8_MAX;
+
+/**
+ * The results of the simulation.
+ */
+static SimulationResults results;
+
+/**
+ * Get the next pseudo-random number (xorshift32).
+ *
+ * @return A pseudo-random number.
+ */
+static uint32_t
+Random(void)
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+
+  return randomState;
+}
+
+/**
+ * Choose from the seed the task that terminates and the task that aborts, and
+ * the job at the beginning of which each one stops.
+ *
+ * Job numbers start at 1 so that 0 means that the task never stops.
+ */
+static void
+ChooseStoppingTasks(void)
+{
+  SimulatedTask *simulatedTask
+    = &simulatedTasks[Random() % simulatedTasksCount];
+  uint8_t i;
+
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    simulatedTasks[i].state = LZ_TASK_STATE_READY;
+  }
+
+  simulatedTask->jobsBeforeStop
+    = (uint16_t)(1U + Random() % MAX_JOBS_BEFORE_STOP);
+  simulatedTask->stopState = LZ_TASK_STATE_TERMINATED;
+
+  if (simulatedTasksCount > 1) {
+    /* The task that follows the terminating one aborts */
+    if (++simulatedTask == &simulatedTasks[simulatedTasksCount]) {
+      simulatedTask = &simulatedTasks[0];
+    }
+
+    simulatedTask->jobsBeforeStop
+      = (uint16_t)(1U + Random() % MAX_JOBS_BEFORE_STOP);
+    simulatedTask->stopState = LZ_TASK_STATE_ABORTED;
+  }
+}
+
+/**
+ * Check the states of the tasks in the kernel snapshot.
+ *
+ * @param taskId The ID of the running task.
+ */
+static void
+CheckKernelSnapshot(const uint8_t taskId)
+{
+  Lz_KernelSnapshot snapshot;
+  Lz_TaskSnapshot tasks[ELEMENTS_COUNT(simulatedTasks) + 1];
+  lz_task_state_t expectedState;
+  uint8_t i;
+
+  if (Lz_GetKernelSnapshot(&snapshot, tasks, ELEMENTS_COUNT(tasks))
+      != simulatedTasksCount + 1U
+      || snapshot.tasksCount != simulatedTasksCount + 1U) {
+    Host_Abort("The snapshot doesn't contain all registered tasks.");
+  }
+
+  /* The idle task is the last one registered */
+  for (i = 0; i <= simulatedTasksCount; ++i) {
+    if (i == taskId) {
+      expectedState = LZ_TASK_STATE_RUNNING;
+    } else if (i == simulatedTasksCount) {
+      expectedState = LZ_TASK_STATE_READY;
+    } else {
+      expectedState = simulatedTasks[i].state;
+    }
+
+    if (tasks[i].state != expectedState) {
+      Host_Abort("The snapshot contains a task in a wrong state.");
+    }
+  }
+}
+
+/**
+ * The entry point of all simulated tasks, that is never executed.
+ */
+static void
+TaskEntryPoint(void)
+{
+  Host_Abort("The entry point of a simulated task has been executed.");
+}
+
+/**
+ * Find the tasks of the schedule table, and their completion times.
+ *
+ * @return
+ *         - _true_ if all task IDs from 0 to the highest one are found.
+ *         - _false_ otherwise.
+ */
+static bool
+ReadScheduleTable(void)
+{
+  uint16_t jobsCounts[ELEMENTS_COUNT(simulatedTasks)] = { 0 };
+  uint16_t slot;
+  uint8_t entry;
+  uint8_t taskId;
+  uint8_t i;
+
+  for (slot = 0; slot < ELEMENTS_COUNT(ScheduleTable); ++slot) {
+    entry = Arch_LoadU8FromProgmem(&ScheduleTable[slot]);
+    taskId = entry & LZ_SCHEDULE_SLOT_TASK_ID_MASK;
+
+    if (LZ_SCHEDULE_SLOT_IDLE == taskId) {
+      continue;
+    }
+
+    ++simulatedTasks[taskId].completion;
+
+    if (entry & LZ_SCHEDULE_SLOT_JOB_START) {
+      ++jobsCounts[taskId];
+    }
+
+    if (taskId >= simulatedTasksCount) {
+      simulatedTasksCount = taskId + 1;
+    }
+  }
+
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    if (0 == jobsCounts[i]) {
+      return false;
+    }
+
+    simulatedTasks[i].completion /= jobsCounts[i];
+  }
+
+  return true;
+}
+
+/**
+ * Get the ID of the task the scheduler must elect for a time slice, and update
+ * the state of the task whose job begins.
+ *
+ * @param now The current clock tick.
+ *
+ * @return The ID of the task to elect, or UINT8_MAX for the idle task.
+ */
+static uint8_t
+GetExpectedTaskId(const uint32_t now)
+{
+  const uint16_t slot = (uint16_t)(now % ELEMENTS_COUNT(ScheduleTable));
+  const uint8_t entry = Arch_LoadU8FromProgmem(&ScheduleTable[slot]);
+  const uint8_t taskId = entry & LZ_SCHEDULE_SLOT_TASK_ID_MASK;
+  SimulatedTask *simulatedTask;
+
+  if (LZ_SCHEDULE_SLOT_IDLE == taskId) {
+    return UINT8_MAX;
+  }
+
+  simulatedTask = &simulatedTasks[taskId];
+
+  if (LZ_TASK_STATE_READY != simulatedTask->state) {
+    return UINT8_MAX;
+  }
+
+  if (entry & LZ_SCHEDULE_SLOT_JOB_START) {
+    if (simulatedTask->jobsBeforeStop > 1) {
+      --simulatedTask->jobsBeforeStop;
+    }
+
+    simulatedTask->remainingSlots = simulatedTask->completion;
+    simulatedTask->remainingWork
+      = (uint16_t)(Random() % (simulatedTask->completion + 1U));
+    simulatedTask->isJobEnded = false;
+    ++results.wakeups;
+    ++results.wakeupsOnTime;
+  }
+
+  if (simulatedTask->isJobEnded || 0 == simulatedTask->remainingSlots) {
+    return UINT8_MAX;
+  }
+
+  return taskId;
+}
+
+/** @name Kernel side */
+/** @{              */
+
+int
+Simulation_Init(unsigned int tasksCount, unsigned long seed)
+{
+  Lz_TaskConfiguration taskConfiguration;
+  uint8_t i;
+
+  if (!ReadScheduleTable() || tasksCount != simulatedTasksCount) {
+    return 0;
+  }
+
+  randomState = (uint32_t)seed;
+
+  /* xorshift32 never leaves the state 0 */
+  if (0 == randomState) {
+    randomState = 1;
+  }
+
+  ChooseStoppingTasks();
+
+  for (i = 0; i < simulatedTasksCount; ++i) {
+    Lz_TaskConfiguration_Init(&taskConfiguration);
+    taskConfiguration.name = "cyclic";
+    taskConfiguration.schedulingPolicy = CYCLIC_RT;
+    taskConfiguration.period = ELEMENTS_COUNT(ScheduleTable);
+    taskConfiguration.completion = simulatedTasks[i].completion;
+
+    if (!Lz_RegisterTask(TaskEntryPoint, &taskConfiguration)) {
+      return 0;
+    }
+  }
+
+  return Lz_SetScheduleTable(ScheduleTable, ELEMENTS_COUNT(ScheduleTable));
+}
+
+void
+Simulation_Start(void)
+{
+  Lz_Run();
+}
+
+void
+Simulation_RunTimeSlice(void)
+{
+  const Task * const task = Scheduler_GetCurrentTask();
+  const uint32_t now = (uint32_t)results.ticks++;
+  const uint8_t expectedTaskId = GetExpectedTaskId(now);
+  SimulatedTask *simulatedTask;
+
+  if (task->id != lastTaskId) {
+    ++results.contextSwitches;
+    lastTaskId = task->id;
+  }
+
+  CheckKernelSnapshot(task->id);
+
+  if (task->id >= simulatedTasksCount) {
+    /* The idle task */
+    if (UINT8_MAX != expectedTaskId) {
+      Host_Abort("The idle task has been elected in the slot of a task.");
+    }
+
+    ++results.idleTicks;
+  } else {
+    if (task->id != expectedTaskId) {
+      Host_Abort("A task has been elected out of its slots.");
+    }
+
+    simulatedTask = &simulatedTasks[task->id];
+    --simulatedTask->remainingSlots;
+
+    if (1 == simulatedTask->jobsBeforeStop) {
+      simulatedTask->state = simulatedTask->stopState;
+
+      if (LZ_TASK_STATE_TERMINATED == simulatedTask->stopState) {
+        Lz_Task_Terminate();
+      } else {
+        Scheduler_AbortTask();
+      }
+    }
+
+    if (0 == simulatedTask->remainingWork) {
+      simulatedTask->isJobEnded = true;
+      ++results.cyclicJobs;
+      Lz_Task_WaitActivation();
+    }
+
+    --simulatedTask->remainingWork;
+  }
+
+  /* Nothing else happens until the end of the time slice */
+  Arch_CpuSleep();
+}
+
+void
+Simulation_GetResults(SimulationResults *simulationResults)
+{
+  *simulationResults = results;
+}
+
+/** @} */
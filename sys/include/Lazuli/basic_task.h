@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Basic tasks interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * Describes the interface for basic tasks.
+ *
+ * A basic task is a function that runs to completion each time it is
+ * activated. All basic tasks run on a single stack, that belongs to a kernel
+ * task, so a basic task costs a few bytes of memory instead of a whole stack.
+ *
+ * Basic tasks are available if the configuration option LZ_CONFIG_BASIC_TASKS
+ * is set.
+ */
+
+#ifndef LAZULI_BASIC_TASK_H
+#define LAZULI_BASIC_TASK_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/list.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Represents the configuration of a basic task.
+ */
+typedef struct {
+  /**
+   * The priority of the basic task, in the same order as the priority of
+   * priority real-time tasks: basic tasks of lower priority numbers run first,
+   * and preempt the basic tasks of greater priority numbers.
+   */
+  lz_task_priority_t priority;
+
+  /**
+   * The period of activation of the basic task, expressed as an integer number
+   * of time units. 0 means that the basic task is not activated periodically.
+   */
+  lz_u_resolution_unit_t period;
+
+  /**
+   * The code of the interrupt that activates the basic task. 0 (i.e. the reset)
+   * means that the basic task is not activated by an interrupt.
+   */
+  uint8_t interruptCode;
+}Lz_BasicTaskConfiguration;
+
+/**
+ * Represents a basic task.
+ *
+ * The members are managed by the kernel, and must not be accessed.
+ */
+typedef struct _Lz_BasicTask {
+  /** The element of the list of periodic or interrupt basic tasks */
+  Lz_LinkedListElement activationQueue;
+
+  /** The element of the list of basic tasks activated and not started yet */
+  Lz_LinkedListElement pendingQueue;
+
+  /** The function of the basic task */
+  void (*entryPoint)(void);
+
+  /** The running basic task that this basic task preempted, or NULL */
+  struct _Lz_BasicTask *preemptedBasicTask;
+
+  /** The stack pointer saved while a basic task of higher priority runs */
+  void *stackPointer;
+
+  /** The period of activation of the basic task */
+  lz_u_resolution_unit_t period;
+
+  /** The time until the next periodic activation of the basic task */
+  lz_u_resolution_unit_t timeUntilActivation;
+
+  /** The priority of the basic task */
+  lz_task_priority_t priority;
+
+  /** The code of the interrupt that activates the basic task */
+  uint8_t interruptCode;
+
+  /** Indicates that the basic task is activated and not started yet */
+  bool isPending;
+}Lz_BasicTask;
+
+/**
+ * Register a new basic task.
+ *
+ * Basic tasks must be registered before calling Lz_Run().
+ *
+ * @param basicTask A pointer to an allocated Lz_BasicTask, that must stay
+ *                  allocated for the whole run of the system.
+ * @param entryPoint The function of the basic task. It must return, and must
+ *                   never call a blocking function of the kernel.
+ * @param configuration A pointer to an Lz_BasicTaskConfiguration containing
+ *                      the configuration of the basic task. If NULL is passed,
+ *                      the basic task has the priority 0, and is only activated
+ *                      by Lz_BasicTask_Activate().
+ *
+ * @return
+ *         - _true_ if the basic task has been registered.
+ *         - _false_ if the configuration option LZ_CONFIG_BASIC_TASKS is not
+ *           set, or if the configuration sets both a period and an interrupt
+ *           code, or an interrupt code that doesn't exist.
+ */
+bool
+Lz_RegisterBasicTask(Lz_BasicTask * const basicTask,
+                     void (* const entryPoint)(void),
+                     const Lz_BasicTaskConfiguration * const configuration);
+
+/**
+ * Activate a basic task, so it runs to completion once.
+ *
+ * The activated basic task runs after the basic tasks of higher or equal
+ * priority already activated. If its priority is higher than the one of the
+ * running basic task, it preempts it at the next clock tick.
+ *
+ * This function can be called by tasks and by basic tasks.
+ *
+ * @param basicTask A pointer to the registered Lz_BasicTask to activate.
+ *
+ * @return
+ *         - _true_ if the basic task has been activated.
+ *         - _false_ if the basic task was already activated and not started
+ *           yet, in which case the activation is lost.
+ */
+bool
+Lz_BasicTask_Activate(Lz_BasicTask * const basicTask);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_BASIC_TASK_H */
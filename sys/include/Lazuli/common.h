@@ -237,7 +237,7 @@ STATIC_ASSERT(sizeof(uint8_t) == 1,
  * @param T The type of the structure.
  */
 #define OFFSET_OF(M, T)                         \
-  ((size_t)(&(((T*)0)->M)))
+  ((size_t)(uintptr_t)(&(((T*)0)->M)))
 
 /**
  * Get a pointer to the structure T containing the member M pointed by P.
@@ -147,6 +147,94 @@ extern const char * const LZ_CONFIG_IDLE_TASK_NAME;
  */
 extern const bool LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES;
 
+/**
+ * When set, output the ID of the running task on a group of pins.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_TASK_ID;
+
+/**
+ * When set, add instrumentation code to measure interrupt handlers.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_INTERRUPTS;
+
+/**
+ * When 1, measure the longest span of time during which interrupts are
+ * disabled.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS;
+
+/**
+ * When 1, paint the stack of each task with a known pattern when it is
+ * registered, so the high-water mark of task stacks can be measured at run
+ * time.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_STACK_USAGE;
+
+/**
+ * When 1, account the CPU time consumed by each task, with a precision of one
+ * system timer count.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_CPU_USAGE;
+
+/**
+ * When 1, measure the timing of each job of cyclic real-time tasks: release
+ * jitter, response time and execution time.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS;
+
+/**
+ * When 1, maintain global counters of the kernel: clock ticks, context
+ * switches, time slices given to the idle task, and handled interrupts.
+ */
+extern const bool LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS;
+
+/**
+ * When 1, provide the schedulability analysis of cyclic real-time tasks.
+ */
+extern const bool LZ_CONFIG_SCHEDULABILITY_ANALYSIS;
+
+/**
+ * When 1, Lz_Run() panics if the cyclic real-time tasks are not schedulable.
+ */
+extern const bool LZ_CONFIG_CHECK_SCHEDULABILITY_AT_RUN;
+
+/**
+ * When 1, Lz_Run() chooses the release offsets of cyclic real-time tasks
+ * registered with LZ_RELEASE_OFFSET_AUTOMATIC.
+ */
+extern const bool LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS;
+
+/**
+ * When 1, the scheduler dispatches tasks from a schedule table.
+ */
+extern const bool LZ_CONFIG_TIME_TRIGGERED_SCHEDULING;
+
+/**
+ * When 1, priority real-time tasks can be given a CPU budget.
+ */
+extern const bool LZ_CONFIG_TASK_BUDGETS;
+
+/**
+ * When 1, run-to-completion basic tasks can be registered.
+ */
+extern const bool LZ_CONFIG_BASIC_TASKS;
+
+/**
+ * The size in bytes of the stack shared by all basic tasks.
+ */
+extern const size_t LZ_CONFIG_BASIC_TASKS_STACK_SIZE;
+
+/**
+ * The worst-case duration of a clock tick, in system timer counts.
+ */
+extern const uint16_t LZ_CONFIG_CLOCK_TICK_OVERHEAD;
+
+/**
+ * When 1, check at each clock tick that the running task didn't overflow its
+ * stack.
+ */
+extern const bool LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW;
+
 /** @} */
 
 /** @name Spinlocks */
@@ -210,6 +298,58 @@ extern const bool LZ_CONFIG_SERIAL_USE_INTERRUPTS;
 
 /** @}           */
 
+/** @name Trace */
+/** @{          */
+
+/**
+ * The number of records of the kernel events trace ring buffer.
+ */
+extern const uint8_t LZ_CONFIG_TRACE_BUFFER_SIZE;
+
+/**
+ * When 1, a kernel task continuously streams the kernel events trace over the
+ * serial line.
+ */
+extern const bool LZ_CONFIG_TRACE_STREAM;
+
+/**
+ * When 1, the trace is streamed as lines of hexadecimal digits.
+ */
+extern const bool LZ_CONFIG_TRACE_STREAM_HEX;
+
+/**
+ * The stack size in bytes of the trace streaming task.
+ */
+extern const size_t LZ_CONFIG_TRACE_STREAM_TASK_STACK_SIZE;
+
+/** @}          */
+
+/** @name Profiler */
+/** @{             */
+
+/**
+ * The number of entries of the hash table of the profiler.
+ */
+extern const uint8_t LZ_CONFIG_PROFILER_TABLE_SIZE;
+
+/** @}             */
+
+/** @name Interrupt latency */
+/** @{                      */
+
+/**
+ * The number of buckets of the latency histogram of each interrupt.
+ */
+extern const uint8_t LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE;
+
+/**
+ * The width of each bucket of the latency histograms, expressed as a power of 2
+ * of system timer counts.
+ */
+extern const uint8_t LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT;
+
+/** @}                      */
+
 /** @name AVR-specific configuration */
 /** @{                               */
 
@@ -259,11 +399,21 @@ extern const bool LZ_CONFIG_AVR_SLEEP_WITH_EXTENDED_STANDBY_MODE;
  */
 extern const bool LZ_CONFIG_MODULE_CLOCK_24_USED;
 
+/**
+ * Use module "interrupt_latency": Interrupt to task latency measurement.
+ */
+extern const bool LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED;
+
 /**
  * Use module "mutex": Mutexes implementation.
  */
 extern const bool LZ_CONFIG_MODULE_MUTEX_USED;
 
+/**
+ * Use module "profiler": Statistical PC-sampling profiler.
+ */
+extern const bool LZ_CONFIG_MODULE_PROFILER_USED;
+
 /**
  * Use module "serial": Serial interface configuration.
  */
@@ -274,6 +424,11 @@ extern const bool LZ_CONFIG_MODULE_SERIAL_USED;
  */
 extern const bool LZ_CONFIG_MODULE_SPINLOCK_USED;
 
+/**
+ * Use module "trace": Kernel events trace.
+ */
+extern const bool LZ_CONFIG_MODULE_TRACE_USED;
+
 /**
  * The port used for instrumentation on AVR machines.
  */
@@ -284,6 +439,23 @@ extern uint16_t LZ_CONFIG_AVR_INSTRUMENT_PORT;
  */
 extern uint8_t LZ_CONFIG_AVR_INSTRUMENT_POSITION;
 
+/**
+ * The position in the instrumentation port used for interrupt handlers on AVR
+ * machines.
+ */
+extern uint8_t LZ_CONFIG_AVR_INSTRUMENT_INTERRUPTS_POSITION;
+
+/**
+ * The port used to output the ID of the running task on AVR machines.
+ */
+extern uint16_t LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT;
+
+/**
+ * The mask of the pins used to output the ID of the running task on AVR
+ * machines.
+ */
+extern uint8_t LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK;
+
 /** @} */
 
 #endif /* LAZULI_CONFIG_STATIC_ANALYSIS_H */
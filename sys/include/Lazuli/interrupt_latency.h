@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Interrupt latency measurement user interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the user interface of the interrupt latency measurement.
+ * The latency of an interrupt is the time between the moment the interrupt
+ * handler is entered and the moment Lz_Task_WaitInterrupt() returns in a task
+ * woken up by this interrupt. Latencies are expressed in system timer counts.
+ */
+
+#ifndef LAZULI_INTERRUPT_LATENCY_H
+#define LAZULI_INTERRUPT_LATENCY_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Represents the statistics of the latencies measured for one interrupt.
+ */
+typedef struct {
+  /**
+   * The number of latencies measured. This value saturates at UINT16_MAX.
+   */
+  uint16_t count;
+
+  /**
+   * The lowest latency measured, or 0 if no latency has been measured.
+   */
+  uint16_t min;
+
+  /**
+   * The highest latency measured. This value saturates at UINT16_MAX.
+   */
+  uint16_t max;
+
+  /**
+   * The histogram of the latencies measured.
+   *
+   * The bucket i counts the latencies between
+   * (i << LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT) included and
+   * ((i + 1) << LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT) excluded. The last
+   * bucket also counts all the latencies that are beyond. Each bucket
+   * saturates at UINT16_MAX.
+   */
+  uint16_t histogram[LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE];
+}Lz_InterruptLatency;
+
+/**
+ * Get the statistics of the latencies measured for an interrupt.
+ *
+ * @param interruptCode The code of the interrupt, as defined in interrupts.h.
+ * @param latency A pointer to the Lz_InterruptLatency to fill.
+ *
+ * @return
+ *         - _true_ if @p latency has been filled.
+ *         - _false_ if @p interruptCode is not a valid interrupt code or if
+ *           @p latency is _NULL_.
+ */
+bool
+Lz_InterruptLatency_Get(const uint8_t interruptCode,
+                        Lz_InterruptLatency * const latency);
+
+/**
+ * Remove all the latencies measured, for all interrupts.
+ */
+void
+Lz_InterruptLatency_Reset(void);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_INTERRUPT_LATENCY_H */
@@ -21,6 +21,8 @@
 #include <Lazuli/common.h>
 #include <Lazuli/config.h>
 
+#include <Lazuli/sys/arch/AVR/interrupts.h>
+
 _EXTERN_C_DECL_BEGIN
 
 /**
@@ -53,14 +55,111 @@ typedef uint8_t lz_scheduling_policy_t;
 /**
  * Priority time sliced real-time scheduling.
  *
- * Equivalent to POSIX SCHED_RR.
+ * Equivalent to POSIX SCHED_RR, with a quantum set per task.
  */
 #define PRIORITY_RT ((lz_scheduling_policy_t)1U)
 
+/**
+ * Cooperative scheduling, below real-time scheduling.
+ *
+ * A cooperative task is never preempted by another cooperative task: it runs
+ * until it waits for an event, yields or terminates. Ready cooperative tasks
+ * run in their order of arrival. Real-time tasks still preempt cooperative
+ * tasks.
+ */
+#define COOPERATIVE ((lz_scheduling_policy_t)2U)
+
 /**
  * Represents the maximum value currently defined for a lz_scheduling_policy_t.
  */
-#define LZ_SCHEDULING_POLICY_MAX PRIORITY_RT
+#define LZ_SCHEDULING_POLICY_MAX COOPERATIVE
+
+/**
+ * Represents the state of a task, i.e. the queue of the scheduler on which it
+ * is.
+ */
+typedef uint8_t lz_task_state_t;
+
+/**
+ * The task is currently running.
+ */
+#define LZ_TASK_STATE_RUNNING ((lz_task_state_t)0U)
+
+/**
+ * The task is ready to run.
+ */
+#define LZ_TASK_STATE_READY ((lz_task_state_t)1U)
+
+/**
+ * The task is waiting for its next activation. Only for cyclic tasks.
+ */
+#define LZ_TASK_STATE_WAITING_ACTIVATION ((lz_task_state_t)2U)
+
+/**
+ * The task is waiting for an interrupt.
+ */
+#define LZ_TASK_STATE_WAITING_INTERRUPT ((lz_task_state_t)3U)
+
+/**
+ * The task is waiting for the expiration of its software timer.
+ */
+#define LZ_TASK_STATE_WAITING_TIMER ((lz_task_state_t)4U)
+
+/**
+ * The task is waiting for a mutex to be unlocked.
+ */
+#define LZ_TASK_STATE_WAITING_MUTEX ((lz_task_state_t)5U)
+
+/**
+ * The task has terminated.
+ */
+#define LZ_TASK_STATE_TERMINATED ((lz_task_state_t)6U)
+
+/**
+ * The task has been aborted by the kernel.
+ */
+#define LZ_TASK_STATE_ABORTED ((lz_task_state_t)7U)
+
+/**
+ * The task has consumed its CPU budget, and waits for its replenishment. Only
+ * for priority tasks.
+ */
+#define LZ_TASK_STATE_THROTTLED ((lz_task_state_t)8U)
+
+/**
+ * The release offset of a cyclic real-time task, to let Lz_Run() choose it.
+ *
+ * Only available if the configuration option
+ * LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS is set.
+ */
+#define LZ_RELEASE_OFFSET_AUTOMATIC ((lz_u_resolution_unit_t)UINT16_MAX)
+
+/**
+ * @name Schedule table
+ *
+ * Each slot of a schedule table is one byte, giving the task to run during one
+ * time slice: the ID of the task, possibly combined with
+ * LZ_SCHEDULE_SLOT_JOB_START, or LZ_SCHEDULE_SLOT_IDLE.
+ *
+ * @{
+ */
+
+/**
+ * The mask of the task ID in a slot of a schedule table.
+ */
+#define LZ_SCHEDULE_SLOT_TASK_ID_MASK ((uint8_t)0x7FU)
+
+/**
+ * The slot of a schedule table where the scheduler idle task runs.
+ */
+#define LZ_SCHEDULE_SLOT_IDLE ((uint8_t)0x7FU)
+
+/**
+ * The flag of a slot of a schedule table where a new job of the task begins.
+ */
+#define LZ_SCHEDULE_SLOT_JOB_START ((uint8_t)0x80U)
+
+/** @} */
 
 /**
  * Represents the configuration of a task.
@@ -90,7 +189,8 @@ typedef struct {
   lz_task_priority_t priority;
 
   /**
-   * The period (T) of the task. Used only for cyclic tasks.
+   * The period (T) of the task. Used for cyclic tasks, and for priority tasks
+   * that have a budget, as the period of replenishment of their budget.
    *
    * The period is expressed as an integer number of time units.
    */
@@ -103,8 +203,391 @@ typedef struct {
    * The completion time is expressed as an integer number of time units.
    */
   lz_u_resolution_unit_t completion;
+
+  /**
+   * The relative deadline (D) of the task, i.e. the time after the release of
+   * a job at which the job must be complete. Used only for cyclic tasks.
+   * It must not be greater than the period. 0 means that the deadline is equal
+   * to the period.
+   *
+   * Cyclic tasks are ordered by deadline: the shorter the deadline, the higher
+   * the priority.
+   *
+   * The deadline is expressed as an integer number of time units.
+   */
+  lz_u_resolution_unit_t deadline;
+
+  /**
+   * The release offset (O) of the task, i.e. the time after the start of the
+   * scheduler at which the first job is released. Used only for cyclic tasks.
+   * It must be lower than the period, or LZ_RELEASE_OFFSET_AUTOMATIC. It must
+   * be 0 if the configuration option LZ_CONFIG_TIME_TRIGGERED_SCHEDULING is
+   * set, as the schedule table releases the first jobs of all tasks.
+   *
+   * Setting different offsets to tasks of harmonic periods avoids releasing
+   * all of them at the same clock tick.
+   *
+   * The offset is expressed as an integer number of time units.
+   */
+  lz_u_resolution_unit_t offset;
+
+  /**
+   * The CPU budget of the task, i.e. the number of time slices it can run per
+   * period. Used only for priority tasks, if the configuration option
+   * LZ_CONFIG_TASK_BUDGETS is set. 0 means that the task has no budget.
+   * It must not be greater than the period.
+   *
+   * Once its budget is consumed, the task is not elected until the budget is
+   * replenished, at the next multiple of the period since the start of the
+   * scheduler, whatever its priority.
+   *
+   * The budget is expressed as an integer number of time units.
+   */
+  lz_u_resolution_unit_t budget;
+
+  /**
+   * The quantum of the task, i.e. the number of consecutive time slices it
+   * runs before the ready tasks of the same priority. Used only for priority
+   * tasks. 0 means 1, the default.
+   *
+   * A task that is preempted by a task of higher priority keeps the rest of its
+   * quantum, and runs again before the tasks of the same priority. A task that
+   * waits for an event gets a new quantum.
+   *
+   * The quantum is expressed as a number of time slices, from 1 to 255.
+   */
+  uint8_t quantum;
 }Lz_TaskConfiguration;
 
+/**
+ * Represents the stack usage of a registered task.
+ */
+typedef struct {
+  /**
+   * The name of the task, or NULL if the task has no name.
+   */
+  char const *name;
+
+  /**
+   * The total size in bytes of the stack allocated for the task, including the
+   * space reserved by the kernel to save the context of the task.
+   */
+  size_t stackSize;
+
+  /**
+   * The high-water mark of the stack, i.e. the maximum number of bytes of the
+   * stack that have been used by the task since it was registered.
+   */
+  size_t maxUsed;
+}Lz_TaskStackUsage;
+
+/**
+ * Represents the CPU usage of a registered task.
+ */
+typedef struct {
+  /**
+   * The name of the task, or NULL if the task has no name.
+   */
+  char const *name;
+
+  /**
+   * The CPU time consumed by the task, expressed in system timer counts.
+   *
+   * On AVR, one system timer count is 8 machine clock cycles.
+   */
+  uint32_t cpuTime;
+
+  /**
+   * The share of the CPU time consumed by the task, in percent of the CPU time
+   * consumed by all tasks.
+   */
+  uint8_t percentage;
+}Lz_TaskCpuUsage;
+
+/**
+ * Represents the statistics of a measured duration.
+ *
+ * Durations are expressed in system timer counts.
+ */
+typedef struct {
+  /**
+   * The lowest duration measured.
+   */
+  uint32_t min;
+
+  /**
+   * The highest duration measured.
+   */
+  uint32_t max;
+
+  /**
+   * The mean of the durations measured.
+   */
+  uint32_t mean;
+}Lz_DurationStatistics;
+
+/**
+ * Represents the timing statistics of the jobs of a cyclic real-time task.
+ *
+ * All durations are expressed in system timer counts.
+ * On AVR, one system timer count is 8 machine clock cycles.
+ */
+typedef struct {
+  /**
+   * The name of the task, or NULL if the task has no name.
+   */
+  char const *name;
+
+  /**
+   * The configured completion time (C) of the task, converted to system timer
+   * counts, to be compared with maxExecutionTime.
+   */
+  uint32_t completionTime;
+
+  /**
+   * The longest execution time of a job, i.e. the observed worst case
+   * execution time.
+   */
+  uint32_t maxExecutionTime;
+
+  /**
+   * The release jitter, i.e. the time between the nominal release of a job
+   * and its first dispatch.
+   */
+  Lz_DurationStatistics releaseJitter;
+
+  /**
+   * The response time, i.e. the time between the nominal release of a job and
+   * its call to Lz_Task_WaitActivation().
+   */
+  Lz_DurationStatistics responseTime;
+
+  /**
+   * The number of jobs that came to completion. This value saturates at
+   * UINT16_MAX.
+   */
+  uint16_t jobsCount;
+
+  /**
+   * The number of jobs that consumed their whole completion time before
+   * calling Lz_Task_WaitActivation(). This value saturates at UINT16_MAX.
+   */
+  uint16_t overrunsCount;
+
+  /**
+   * The number of jobs that were not complete at their deadline. This value
+   * saturates at UINT16_MAX.
+   */
+  uint16_t deadlineMissesCount;
+}Lz_CyclicTaskStatistics;
+
+/**
+ * Represents the worst-case response time of a cyclic real-time task, computed
+ * by the schedulability analysis.
+ *
+ * Durations are expressed in time units, i.e. in time slices.
+ */
+typedef struct {
+  /**
+   * The name of the task, or NULL if the task has no name.
+   */
+  char const *name;
+
+  /**
+   * The period (T) of the task.
+   */
+  lz_u_resolution_unit_t period;
+
+  /**
+   * The completion time (C) of the task.
+   */
+  lz_u_resolution_unit_t completion;
+
+  /**
+   * The relative deadline (D) of the task.
+   */
+  lz_u_resolution_unit_t deadline;
+
+  /**
+   * The worst-case response time (R) of the task, i.e. the longest time
+   * between the release of a job and the end of its last time slice.
+   * This value is only meaningful if isSchedulable is true, otherwise it is
+   * the first value found above the deadline.
+   */
+  uint32_t responseTime;
+
+  /**
+   * The execution time available to a job, i.e. its completion time minus the
+   * duration of the clock ticks that happen during it. It is expressed in
+   * system timer counts, to be compared with the measured worst case
+   * execution time of the task.
+   */
+  uint32_t availableExecutionTime;
+
+  /**
+   * true if every job of the task completes before its deadline, i.e. if
+   * responseTime <= deadline.
+   */
+  bool isSchedulable;
+}Lz_TaskResponseTime;
+
+/**
+ * Represents the result of the schedulability analysis of the registered
+ * cyclic real-time tasks.
+ *
+ * Ratios are expressed in permille.
+ */
+typedef struct {
+  /**
+   * The number of registered cyclic real-time tasks.
+   */
+  uint8_t cyclicTasksCount;
+
+  /**
+   * The utilization (U) of the CPU by the cyclic real-time tasks, i.e. the sum
+   * of C/T of all tasks, rounded up.
+   */
+  uint16_t cyclicUtilization;
+
+  /**
+   * The share of each time slice taken by the clock tick, rounded up, as
+   * configured by LZ_CONFIG_CLOCK_TICK_OVERHEAD.
+   */
+  uint16_t tickOverhead;
+
+  /**
+   * The load of the CPU, i.e. the utilization of the cyclic real-time tasks
+   * plus the clock ticks happening in the rest of the time.
+   */
+  uint16_t cpuLoad;
+
+  /**
+   * The Liu-Layland bound of the rate monotonic scheduling for this number of
+   * tasks, i.e. n * (2^(1/n) - 1), rounded down. It only applies if all
+   * deadlines are equal to the periods.
+   */
+  uint16_t liuLaylandBound;
+
+  /**
+   * true if cyclicUtilization is under liuLaylandBound. This is a sufficient
+   * condition of schedulability, not a necessary one. Always false if the
+   * deadline of a task is shorter than its period.
+   */
+  bool isUnderLiuLaylandBound;
+
+  /**
+   * true if all cyclic real-time tasks meet their deadlines, according to
+   * their worst-case response times. This is the exact result.
+   */
+  bool isSchedulable;
+}Lz_SchedulabilityAnalysis;
+
+/**
+ * The interrupt code of a critical section that is not an interrupt handler.
+ */
+#define LZ_CRITICAL_SECTION_NO_INTERRUPT ((uint8_t)0xFFU)
+
+/**
+ * Represents a critical section, i.e. a span of time during which interrupts
+ * are disabled.
+ */
+typedef struct {
+  /**
+   * The duration of the critical section, expressed in system timer counts.
+   *
+   * On AVR, one system timer count is 8 machine clock cycles.
+   */
+  uint16_t duration;
+
+  /**
+   * The location in program memory where interrupts have been disabled, as a
+   * word address (i.e. the byte address divided by 2). This is the return
+   * address of the call that disabled interrupts.
+   *
+   * 0 if the critical section is an interrupt handler.
+   */
+  uint16_t location;
+
+  /**
+   * The interrupt code of the interrupt handler, as defined in interrupts.h, or
+   * LZ_CRITICAL_SECTION_NO_INTERRUPT if the critical section is not an
+   * interrupt handler.
+   */
+  uint8_t interruptCode;
+}Lz_CriticalSection;
+
+/**
+ * The interrupt code of a task snapshot when the task is not waiting for an
+ * interrupt.
+ */
+#define LZ_TASK_SNAPSHOT_NO_INTERRUPT ((uint8_t)0xFFU)
+
+/**
+ * Represents the state of a registered task, at the time of a snapshot.
+ */
+typedef struct {
+  /**
+   * The name of the task, or NULL if the task has no name.
+   */
+  char const *name;
+
+  /**
+   * The scheduling policy of the task.
+   */
+  lz_scheduling_policy_t schedulingPolicy;
+
+  /**
+   * The priority of the task. Only meaningful for priority real-time tasks.
+   */
+  lz_task_priority_t priority;
+
+  /**
+   * The state of the task.
+   */
+  lz_task_state_t state;
+
+  /**
+   * The code of the interrupt the task is waiting for, as defined in
+   * interrupts.h, or LZ_TASK_SNAPSHOT_NO_INTERRUPT if the task is not in the
+   * state LZ_TASK_STATE_WAITING_INTERRUPT.
+   */
+  uint8_t interruptCode;
+}Lz_TaskSnapshot;
+
+/**
+ * Represents the global counters of the kernel, at the time of a snapshot.
+ *
+ * All counters wrap around on overflow, so they are meant to be compared
+ * between 2 snapshots.
+ */
+typedef struct {
+  /**
+   * The number of clock ticks since the scheduler started.
+   */
+  uint32_t ticksCount;
+
+  /**
+   * The number of clock ticks that switched to a different task.
+   */
+  uint32_t contextSwitchesCount;
+
+  /**
+   * The number of time slices given to the scheduler idle task.
+   */
+  uint32_t idleTicksCount;
+
+  /**
+   * The number of times each interrupt has been handled, indexed by the codes
+   * defined in interrupts.h. Clock ticks are not counted here.
+   */
+  uint16_t interruptsCounts[INT_TOTAL];
+
+  /**
+   * The number of registered tasks, including the scheduler idle task.
+   */
+  uint8_t tasksCount;
+}Lz_KernelSnapshot;
+
 /**
  * Register a new task.
  *
@@ -147,14 +630,41 @@ Lz_TaskConfiguration_Init(Lz_TaskConfiguration * const taskConfiguration);
 void
 Lz_Run(void);
 
+/**
+ * Set the schedule table of the time-triggered scheduler.
+ *
+ * At each clock tick, the scheduler runs the task of the next slot of the
+ * table, and starts again from the first slot after the last one. A task is
+ * given the slots of a job from its slot marked with
+ * LZ_SCHEDULE_SLOT_JOB_START, until it calls Lz_Task_WaitActivation() or
+ * consumes its completion time. In the remaining slots of the job, the idle
+ * task runs. A task that waits for an interrupt, a software timer or a mutex
+ * makes the scheduler call Kernel_Panic().
+ *
+ * The table is read from program memory, so it must be declared PROGMEM. It is
+ * checked against the registered tasks by Lz_Run(), that calls Kernel_Panic()
+ * if a slot refers to a task that is not a registered cyclic real-time task.
+ * This function must be called before Lz_Run().
+ *
+ * @param table A pointer to the schedule table, in program memory.
+ * @param length The number of slots of @p table.
+ *
+ * @return
+ *         - _true_ if the table has been set.
+ *         - _false_ if the table is empty or if the configuration option
+ *           LZ_CONFIG_TIME_TRIGGERED_SCHEDULING is not set.
+ */
+bool
+Lz_SetScheduleTable(const uint8_t * const table, const uint16_t length);
+
 /**
  * Wait for a specific interrupt to occur.
  * Puts the calling task to sleep until the specified interrupt occurs.
  *
  * @param interruptCode The code of the interrupt to wait for.
  *
- * @attention Only tasks with scheduling policy PRIORITY_RT can wait for
- *            interrupts.
+ * @attention Only tasks with scheduling policy PRIORITY_RT or COOPERATIVE can
+ *            wait for interrupts.
  */
 void
 Lz_Task_WaitInterrupt(uint8_t interruptCode);
@@ -206,11 +716,167 @@ Lz_Task_WaitActivation(void);
  *
  * @param units The number of time slices to wait.
  *
- * @warning Only works for tasks with PRIORITY_RT policy.
+ * @warning Only works for tasks with PRIORITY_RT or COOPERATIVE policy.
  */
 void
 Lz_WaitTimer(lz_u_resolution_unit_t units);
 
+/**
+ * Give up the processor until the end of the current time slice, and let the
+ * other ready tasks of the same policy run before the calling task.
+ *
+ * A cooperative task is moved behind the ready cooperative tasks. A priority
+ * task is moved behind the ready tasks of the same priority, and gets a new
+ * quantum. The calling task stays ready.
+ */
+void
+Lz_Task_Yield(void);
+
+/**
+ * Get the high-water mark of the stack of the calling task.
+ *
+ * @return The maximum number of bytes of its stack that the calling task has
+ *         used since it was registered, or 0 if the configuration option
+ *         LZ_CONFIG_INSTRUMENT_STACK_USAGE is not set.
+ */
+size_t
+Lz_Task_GetStackHighWaterMark(void);
+
+/**
+ * Get the stack usage of all registered tasks, including the scheduler idle
+ * task.
+ *
+ * Tasks are reported in their order of registration, the idle task being the
+ * last one.
+ *
+ * @param stackUsages A pointer to a table of Lz_TaskStackUsage to fill.
+ * @param tableSize The number of elements of the table @p stackUsages.
+ *
+ * @return The number of elements of @p stackUsages that have been filled, or 0
+ *         if the configuration option LZ_CONFIG_INSTRUMENT_STACK_USAGE is not
+ *         set.
+ */
+uint8_t
+Lz_GetTasksStackUsage(Lz_TaskStackUsage * const stackUsages,
+                      const uint8_t tableSize);
+
+/**
+ * Get the CPU usage of all registered tasks, including the scheduler idle task.
+ *
+ * Tasks are reported in their order of registration, the idle task being the
+ * last one. The CPU time of the idle task includes the time during which the
+ * other tasks were sleeping until the end of their time slice.
+ *
+ * @param cpuUsages A pointer to a table of Lz_TaskCpuUsage to fill.
+ * @param tableSize The number of elements of the table @p cpuUsages.
+ *
+ * @return The number of elements of @p cpuUsages that have been filled, or 0
+ *         if the configuration option LZ_CONFIG_INSTRUMENT_CPU_USAGE is not
+ *         set or if the scheduler is not started.
+ */
+uint8_t
+Lz_GetTasksCpuUsage(Lz_TaskCpuUsage * const cpuUsages, const uint8_t tableSize);
+
+/**
+ * Reset the CPU time counters of all registered tasks.
+ *
+ * The counters overflow after 2^32 system timer counts (more than 35 minutes
+ * on AVR at 16 MHz), so they should be reset periodically.
+ */
+void
+Lz_ResetTasksCpuUsage(void);
+
+/**
+ * Get the timing statistics of the jobs of all registered cyclic real-time
+ * tasks.
+ *
+ * Tasks are reported in their order of registration.
+ *
+ * @param statistics A pointer to a table of Lz_CyclicTaskStatistics to fill.
+ * @param tableSize The number of elements of the table @p statistics.
+ *
+ * @return The number of elements of @p statistics that have been filled, or 0
+ *         if the configuration option LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS is not
+ *         set.
+ */
+uint8_t
+Lz_GetCyclicTasksStatistics(Lz_CyclicTaskStatistics * const statistics,
+                            const uint8_t tableSize);
+
+/**
+ * Reset the timing statistics of all registered cyclic real-time tasks.
+ */
+void
+Lz_ResetCyclicTasksStatistics(void);
+
+/**
+ * Perform the schedulability analysis of all registered cyclic real-time
+ * tasks, from their periods and completion times.
+ *
+ * Cyclic real-time tasks are scheduled deadline monotonic, with a time slice
+ * resolution. The worst-case response time of a task is found when all tasks
+ * are released at the same time, as they are when the scheduler starts. Tasks
+ * of same deadline are considered to interfere with each other.
+ * Release offsets are not taken into account, so the response times of tasks
+ * with offsets are upper bounds.
+ *
+ * This function can be called before Lz_Run(), as soon as tasks are
+ * registered.
+ *
+ * @param analysis A pointer to the Lz_SchedulabilityAnalysis to fill.
+ * @param responseTimes A pointer to a table of Lz_TaskResponseTime to fill,
+ *                      in the order of registration of tasks. Can be NULL.
+ * @param tableSize The number of elements of the table @p responseTimes.
+ *
+ * @return The number of elements of @p responseTimes that have been filled, or
+ *         0 if the configuration option LZ_CONFIG_SCHEDULABILITY_ANALYSIS is
+ *         not set.
+ */
+uint8_t
+Lz_AnalyzeSchedulability(Lz_SchedulabilityAnalysis * const analysis,
+                         Lz_TaskResponseTime * const responseTimes,
+                         const uint8_t tableSize);
+
+/**
+ * Get the longest critical section measured, i.e. the longest span of time
+ * during which interrupts have been disabled.
+ *
+ * @param criticalSection A pointer to the Lz_CriticalSection to fill. Its
+ *                        duration is set to 0 if the configuration option
+ *                        LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS is not set.
+ */
+void
+Lz_GetLongestCriticalSection(Lz_CriticalSection * const criticalSection);
+
+/**
+ * Reset the measure of the longest critical section.
+ */
+void
+Lz_ResetLongestCriticalSection(void);
+
+/**
+ * Take a consistent snapshot of the state of the kernel: the global counters
+ * and the state of all registered tasks.
+ *
+ * Tasks are reported in their order of registration, the idle task being the
+ * last one.
+ *
+ * Interrupts are disabled during the whole snapshot, for a time proportional
+ * to the number of registered tasks.
+ *
+ * @param snapshot A pointer to the Lz_KernelSnapshot to fill. Its counters are
+ *                 set to 0 if the configuration option
+ *                 LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS is not set.
+ * @param tasks A pointer to a table of Lz_TaskSnapshot to fill, or NULL.
+ * @param tableSize The number of elements of the table @p tasks.
+ *
+ * @return The number of elements of @p tasks that have been filled.
+ */
+uint8_t
+Lz_GetKernelSnapshot(Lz_KernelSnapshot * const snapshot,
+                     Lz_TaskSnapshot * const tasks,
+                     const uint8_t tableSize);
+
 _EXTERN_C_DECL_END
 
 #endif /* LAZULI_LAZULI_H */
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Statistical profiler user interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the user interface of the statistical profiler.
+ * At each clock tick, the program counter of the interrupted task is sampled
+ * and counted in a hash table, that can be read by a user task.
+ */
+
+#ifndef LAZULI_PROFILER_H
+#define LAZULI_PROFILER_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Represents the number of samples of one program counter value, for one task.
+ */
+typedef struct {
+  /**
+   * The sampled program counter, as a word address (i.e. the byte address
+   * divided by 2).
+   */
+  uint16_t pc;
+
+  /**
+   * The number of samples of this program counter. This value saturates at
+   * UINT16_MAX.
+   */
+  uint16_t count;
+
+  /**
+   * The ID of the task that was running, i.e. its registration order.
+   */
+  uint8_t taskId;
+}Lz_ProfilerSample;
+
+/**
+ * Get the samples of the profiler.
+ *
+ * Samples are copied in no particular order. To read all the samples with a
+ * small table, call this function repeatedly with the same @p cursor, until it
+ * returns 0.
+ *
+ * @param samples A pointer to a table of Lz_ProfilerSample to fill.
+ * @param maxCount The number of elements of the table @p samples.
+ * @param cursor A pointer to the position where to continue reading. Must be
+ *               set to 0 before the first call, then is updated by each call.
+ *
+ * @return The number of samples copied to @p samples.
+ */
+uint8_t
+Lz_Profiler_GetSamples(Lz_ProfilerSample * const samples,
+                       const uint8_t maxCount,
+                       uint8_t * const cursor);
+
+/**
+ * Get the number of samples lost because the hash table of the profiler was
+ * full.
+ *
+ * @return The number of samples lost since the last reset. This value
+ *         saturates at UINT16_MAX.
+ */
+uint16_t
+Lz_Profiler_GetLostSamplesCount(void);
+
+/**
+ * Remove all the samples of the profiler.
+ */
+void
+Lz_Profiler_Reset(void);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_PROFILER_H */
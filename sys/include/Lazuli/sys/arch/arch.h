@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 #include <Lazuli/common.h>
+#include <Lazuli/lazuli.h>
 #include <Lazuli/list.h>
 #include <Lazuli/serial.h>
 #include <Lazuli/sys/compiler.h>
@@ -191,11 +192,19 @@ void
 Arch_CpuSleep(void);
 
 /**
- * Initialize the context switch instrumentation.
+ * Initialize the context switch, task ID and interrupts instrumentation.
  */
 void
 Arch_InitInstrumentation(void);
 
+/**
+ * Output the ID of the task being switched in on the instrumentation pins.
+ *
+ * @param taskId The ID of the task.
+ */
+void
+Arch_InstrumentTaskId(const uint8_t taskId);
+
 /** @name System timer */
 /** @{                 */
 
@@ -211,6 +220,80 @@ Arch_InitSystemTimer(void);
 void
 Arch_StartSystemTimer(void);
 
+/**
+ * Get the current value of the system timer counter.
+ *
+ * The counter is reset at each clock tick, so the returned value is the time
+ * elapsed since the last clock tick, expressed in system timer counts.
+ *
+ * @return The current value of the system timer counter.
+ */
+uint16_t
+Arch_GetSystemTimerCounter(void);
+
+/**
+ * Get the number of system timer counts between 2 clock ticks.
+ *
+ * @return The period of the clock tick, expressed in system timer counts.
+ */
+uint16_t
+Arch_GetSystemTimerPeriod(void);
+
+/**
+ * Check if a clock tick is pending, i.e. the system timer counter has reached
+ * the end of its period but the clock tick interrupt has not been handled yet.
+ *
+ * This can only happen when interrupts are disabled.
+ *
+ * @return
+ *         - _true_ if a clock tick is pending.
+ *         - _false_ otherwise.
+ */
+bool
+Arch_IsSystemTimerTickPending(void);
+
+/**
+ * Record the beginning of a critical section, i.e. interrupts have just been
+ * disabled.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param location The word address in program memory where interrupts have
+ *                 been disabled, or 0 for an interrupt handler.
+ * @param interruptCode The interrupt code of the interrupt handler, or
+ *                      LZ_CRITICAL_SECTION_NO_INTERRUPT.
+ */
+void
+Arch_RecordCriticalSectionBegin(const uint16_t location,
+                                const uint8_t interruptCode);
+
+/**
+ * Record the end of a critical section, i.e. interrupts are about to be
+ * enabled.
+ *
+ * Must be called with interrupts disabled.
+ */
+void
+Arch_RecordCriticalSectionEnd(void);
+
+/**
+ * Get the longest critical section recorded.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param criticalSection A pointer to the Lz_CriticalSection to fill.
+ */
+void
+Arch_GetLongestCriticalSection(Lz_CriticalSection * const criticalSection);
+
+/**
+ * Reset the longest critical section recorded.
+ *
+ * Must be called with interrupts disabled.
+ */
+void
+Arch_ResetLongestCriticalSection(void);
+
 /** @}                 */
 
 /** @name Mutex */
@@ -258,6 +341,11 @@ Arch_SetSerialConfiguration(const Lz_SerialConfiguration * const configuration);
 void
 Arch_InitSerial(void);
 
+/** @} */
+
+/** @name Arithmetic */
+/** @{               */
+
 /**
  * Represents the result of a uin16_t division.
  */
@@ -283,6 +371,39 @@ typedef struct {
 U16DivisionResult
 Arch_Divide_U16(uint16_t numerator, uint16_t denominator);
 
+/**
+ * Represents the result of a uint32_t division.
+ */
+typedef struct {
+  uint32_t remainder; /**< The remainder of the division */
+  uint32_t quotient;  /**< The quotient of the division  */
+}U32DivisionResult;
+
+/**
+ * Perform the Euclidean division between two uint32_t operands.
+ *
+ * @param numerator The numerator of the division.
+ * @param denominator The denominator of the division.
+ *
+ * @return A U32DivisionResult by value.
+ *
+ * @warning A division by zero is considered as a failure, and is handled by
+ *          Kernel_ManageFailure().
+ */
+U32DivisionResult
+Arch_Divide_U32(uint32_t numerator, uint32_t denominator);
+
+/**
+ * Perform the multiplication of two uint32_t operands.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ *
+ * @return The 32 low bits of the product.
+ */
+uint32_t
+Arch_Multiply_U32(uint32_t a, uint32_t b);
+
 /** @} */
 
 _EXTERN_C_DECL_END
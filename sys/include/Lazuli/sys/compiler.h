@@ -68,6 +68,19 @@
   __attribute__                                                         \
   ((section(COMPILER_H_TOSTRING(COMPILER_H_GENERATE_PROGMEM_SECTION_NAME()))))
 
+/**
+ * Declare a string literal to be stored in program memory, and obtain a
+ * pointer to it.
+ * i.e. the string will not be copied to RAM at system startup.
+ *
+ * Strings declared with PSTR must be read with Arch_LoadU8FromProgmem(), or
+ * used with the "_P" variants of functions, like printf_P() and puts_P().
+ *
+ * @param S The string literal.
+ */
+#define PSTR(S)                                                         \
+  (__extension__({ static PROGMEM const char pstr[] = (S); &pstr[0]; }))
+
 /**
  * Declare a global uninitialized variable to be excluded from ".bss" section.
  * In ISO C, all uninitialized global variables go to the ".bss" section, and
@@ -87,6 +100,7 @@
 
 #define NORETURN
 #define PROGMEM
+#define PSTR(S) (S)
 #define NOINIT
 
 #endif/* __GNUC__ */
@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Interrupt latency measurement kernel interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the kernel interface of the interrupt latency
+ * measurement.
+ */
+
+#ifndef LAZULI_SYS_INTERRUPT_LATENCY_H
+#define LAZULI_SYS_INTERRUPT_LATENCY_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/interrupt_latency.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Record the latency of an interrupt, from its timestamp until now.
+ *
+ * @param interruptCode The code of the interrupt, as defined in interrupts.h.
+ * @param timestamp The timestamp taken when the interrupt handler was entered,
+ *                  with Scheduler_GetTimestamp().
+ */
+void
+InterruptLatency_Record(const uint8_t interruptCode, const uint32_t timestamp);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_SYS_INTERRUPT_LATENCY_H */
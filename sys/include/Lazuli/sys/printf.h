@@ -37,6 +37,24 @@ _EXTERN_C_DECL_BEGIN
 uint8_t
 Printf_ConvertU16ToDecimal(uint16_t i, char buffer[]);
 
+/**
+ * Convert an unsigned 32-bit integer to its ASCII decimal representation.
+ * @warning The conversion is put in the buffer @p buffer **in reverse order**
+ * and **without a final NUL character**. The caller of this function then has
+ * to use the return value in order to use the characters in the buffer in the
+ * right order.
+ *
+ * This function will always succeed.
+ *
+ * @param i The 32-bit input value to convert.
+ * @param buffer A valid pointer to an allocated string of minimum size 10
+ *               bytes.
+ *
+ * @return The number of characters actually written to the buffer.
+ */
+uint8_t
+Printf_ConvertU32ToDecimal(uint32_t i, char buffer[]);
+
 _EXTERN_C_DECL_END
 
 #endif /* LAZULI_SYS_PRINTF_H */
@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Statistical profiler kernel interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the kernel interface of the statistical profiler.
+ */
+
+#ifndef LAZULI_SYS_PROFILER_H
+#define LAZULI_SYS_PROFILER_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/profiler.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Count one sample of a program counter for a task.
+ *
+ * @param taskId The ID of the task that was running.
+ * @param pc The sampled program counter, as a word address.
+ */
+void
+Profiler_Sample(const uint8_t taskId, const uint16_t pc);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_SYS_PROFILER_H */
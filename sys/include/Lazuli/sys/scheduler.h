@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 
+#include <Lazuli/basic_task.h>
 #include <Lazuli/common.h>
 #include <Lazuli/lazuli.h>
 #include <Lazuli/mutex.h>
@@ -87,6 +88,8 @@ Scheduler_WaitEvent(void * const sp, const uint8_t eventCode);
 /**
  * Wake up all tasks waiting for a mutex.
  *
+ * This function must be called with interrupts disabled.
+ *
  * @param mutex A pointer to the mutex the tasks are waiting for.
  */
 void
@@ -100,12 +103,94 @@ Scheduler_WakeupTasksWaitingMutex(Lz_Mutex * const mutex);
 Task*
 Scheduler_GetCurrentTask(void);
 
+/**
+ * Compute the high-water mark of the stack of a task.
+ *
+ * The stack of the task is scanned from its lowest address, i.e. the deepest
+ * byte the stack can grow to, up to the first byte that doesn't contain
+ * STACK_PAINT_PATTERN anymore.
+ *
+ * @param task A valid pointer to the Task, whose stack has been painted with
+ *             STACK_PAINT_PATTERN when allocated.
+ *
+ * @return The maximum number of bytes of its stack that the task has used.
+ */
+size_t
+Scheduler_GetStackHighWaterMark(const Task * const task);
+
+/**
+ * Check if a task has overflowed its stack.
+ *
+ * The check is made on 2 criteria:
+ *   - The guard word STACK_GUARD_WORD, placed right below the stack of the
+ *     task, must be intact.
+ *   - The stack pointer @p sp must be in the range
+ *     [stackOrigin - stackSize, stackOrigin].
+ *
+ * @param task A valid pointer to the Task to check.
+ * @param sp The stack pointer of the task.
+ *
+ * @return
+ *         - _true_ if the task has overflowed its stack.
+ *         - _false_ if the stack of the task is safe.
+ */
+bool
+Scheduler_IsStackOverflowed(const Task * const task, const void * const sp);
+
+/**
+ * Get the current timestamp, expressed in system timer counts since the start
+ * of the system timer. The timestamp wraps around on overflow.
+ *
+ * Timestamps are only maintained when a feature that needs them is enabled.
+ * Otherwise this function always returns the value of the system timer
+ * counter.
+ *
+ * This function must be called with interrupts disabled.
+ *
+ * @return The current timestamp.
+ */
+uint32_t
+Scheduler_GetTimestamp(void);
+
 /**
  * Put the current task to sleep until the end of its time slice.
  */
 void
 Scheduler_SleepUntilEndOfTimeSlice(void);
 
+/**
+ * Start the next basic task to run on the current level of the stack of basic
+ * tasks, i.e. the first activated basic task, if its priority is higher than
+ * the one of the running basic task.
+ *
+ * This function is called by the task running basic tasks.
+ *
+ * @return
+ *         - A pointer to the Lz_BasicTask to run.
+ *         - _NULL_ if no basic task must run on the current level.
+ */
+Lz_BasicTask *
+Scheduler_StartBasicTask(void);
+
+/**
+ * End the running basic task, so the basic task it preempted, if any, is the
+ * running one again.
+ *
+ * This function is called by the task running basic tasks, when the function
+ * of the running basic task returns.
+ */
+void
+Scheduler_EndBasicTask(void);
+
+/**
+ * Get the number of basic tasks preempted by another basic task, i.e. the
+ * number of levels of the stack of basic tasks below the current one.
+ *
+ * @return The number of preempted basic tasks.
+ */
+uint8_t
+Scheduler_GetBasicTasksNestingLevel(void);
+
 _EXTERN_C_DECL_END
 
 #endif /* LAZULI_SYS_SCHEDULER_H */
@@ -76,6 +76,126 @@ typedef u_read_write_atomic_t lz_task_to_scheduler_message_t;
  */
 #define ABORT_TASK ((lz_task_to_scheduler_message_t)6U)
 
+/**
+ * Give up the processor until the end of the time slice. The task stays ready,
+ * behind the other ready tasks of the same policy.
+ */
+#define YIELD_TASK ((lz_task_to_scheduler_message_t)7U)
+
+/**
+ * Sent by the task running basic tasks when no more basic task must run on
+ * the current level of its stack. The task goes back to the preempted basic
+ * task, if any, or waits for the activation of a basic task.
+ */
+#define END_BASIC_TASKS ((lz_task_to_scheduler_message_t)8U)
+
+/**
+ * The byte pattern used to paint task stacks when they are allocated.
+ *
+ * Used to measure the stack high-water mark of tasks. See the configuration
+ * option LZ_CONFIG_INSTRUMENT_STACK_USAGE.
+ */
+#define STACK_PAINT_PATTERN ((uint8_t)0xA5U)
+
+/**
+ * The guard word placed right below the lowest address of each task stack.
+ *
+ * If this word is overwritten, the task has overflowed its stack. See the
+ * configuration option LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW.
+ */
+#define STACK_GUARD_WORD ((uint16_t)0x5EC7U)
+
+/**
+ * Accumulates the measures of a duration, to compute their minimum, maximum
+ * and mean.
+ */
+typedef struct {
+  /**
+   * The lowest duration measured.
+   */
+  uint32_t min;
+
+  /**
+   * The highest duration measured.
+   */
+  uint32_t max;
+
+  /**
+   * The sum of the durations measured.
+   * When it would overflow, both the sum and the count are halved, so the mean
+   * is kept.
+   */
+  uint32_t sum;
+
+  /**
+   * The number of durations in the sum.
+   */
+  uint16_t count;
+}DurationAccumulator;
+
+/**
+ * The timing statistics of the jobs of a cyclic real-time task.
+ *
+ * All durations and timestamps are expressed in system timer counts.
+ */
+typedef struct {
+  /**
+   * The timestamp of the nominal release of the current job.
+   */
+  uint32_t releaseTimestamp;
+
+  /**
+   * The timestamp of the last time the task was switched in.
+   */
+  uint32_t dispatchTimestamp;
+
+  /**
+   * The execution time consumed by the current job so far.
+   */
+  uint32_t executionTime;
+
+  /**
+   * The longest execution time of a job.
+   */
+  uint32_t maxExecutionTime;
+
+  /**
+   * The release jitter of jobs.
+   */
+  DurationAccumulator releaseJitter;
+
+  /**
+   * The response time of jobs.
+   */
+  DurationAccumulator responseTime;
+
+  /**
+   * The number of jobs that came to completion.
+   */
+  uint16_t jobsCount;
+
+  /**
+   * The number of jobs that consumed their whole completion time.
+   */
+  uint16_t overrunsCount;
+
+  /**
+   * The number of jobs that were not complete at their deadline.
+   */
+  uint16_t deadlineMissesCount;
+
+  /**
+   * Indicates that the current job has already been dispatched.
+   */
+  bool isDispatched;
+
+  /**
+   * Indicates that the current job has ended, i.e. it called
+   * Lz_Task_WaitActivation() or consumed its whole completion time.
+   */
+  bool isEnded;
+}JobStatistics;
+
 /**
  * Represents a task.
  */
@@ -87,6 +207,14 @@ typedef struct {
    */
   const char *name;
 
+  /**
+   * The identifier of the task, attributed in order of registration, starting
+   * from 0.
+   *
+   * > Never changes once the Task is allocated.
+   */
+  uint8_t id;
+
   /**
    * Entry point of execution of the task.
    *
@@ -129,6 +257,13 @@ typedef struct {
    */
   Lz_LinkedListElement stateQueue;
 
+  /**
+   * The element linking the task in the queue of all registered tasks.
+   *
+   * > Never changes once the Task is allocated.
+   */
+  Lz_LinkedListElement registeredTasksQueue;
+
   /**
    * The period (T) of the task, expressed as an integer number of time units.
    * Defined by task configuration when registering task, then left read-only.
@@ -137,19 +272,37 @@ typedef struct {
 
   /**
    * The completion time (C) of the task (worst case execution time), expressed
-   * as an integer number of time units.
+   * as an integer number of time units. For a priority real-time task, the CPU
+   * budget of the task, or 0 if it has no budget.
    * Defined by task configuration when registering task, then left read-only.
    */
   lz_u_resolution_unit_t completion;
 
   /**
-   * The number of time units until the task will complete its execution.
+   * The relative deadline (D) of the task, expressed as an integer number of
+   * time units.
+   * Defined by task configuration when registering task, then left read-only.
+   */
+  lz_u_resolution_unit_t deadline;
+
+  /**
+   * The release offset (O) of the task, expressed as an integer number of
+   * time units, or LZ_RELEASE_OFFSET_AUTOMATIC until Lz_Run() chooses it.
+   * Defined by task configuration when registering task, then left read-only.
+   */
+  lz_u_resolution_unit_t offset;
+
+  /**
+   * The number of time units until the task will complete its execution. For
+   * a priority real-time task, the remaining CPU budget.
    * Updated by scheduler.
    */
   lz_u_resolution_unit_t timeUntilCompletion;
 
   /**
-   * The number of time units until the task will be activated.
+   * The number of time units until the task will be activated. For a priority
+   * real-time task that has a budget, the number of time units until the
+   * budget is replenished.
    * Updated by scheduler.
    */
   lz_u_resolution_unit_t timeUntilActivation;
@@ -159,6 +312,19 @@ typedef struct {
    */
   lz_task_priority_t priority;
 
+  /**
+   * The number of consecutive time slices the task runs before the tasks of
+   * the same priority, from 1 to 255. Only used for non-cyclic tasks.
+   * Defined by task configuration when registering task, then left read-only.
+   */
+  uint8_t quantum;
+
+  /**
+   * The number of time slices until the quantum of the task expires.
+   * Updated by scheduler.
+   */
+  uint8_t timeUntilQuantumExpiration;
+
   /**
    * The number of time units until the software timer expires for the task.
    */
@@ -185,6 +351,12 @@ typedef struct {
    * This parameter is a "universal pointer" to the actual parameter.
    */
   void *taskToSchedulerMessageParameter;
+
+  /**
+   * The timing statistics of the jobs of the task, or NULL if the task is not
+   * a cyclic real-time task or if they are not measured.
+   */
+  JobStatistics *jobStatistics;
 }Task;
 
 /**
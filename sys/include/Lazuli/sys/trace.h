@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Kernel events trace kernel interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the kernel interface of the kernel events trace.
+ */
+
+#ifndef LAZULI_SYS_TRACE_H
+#define LAZULI_SYS_TRACE_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/trace.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Record an event in the trace, if the module "trace" is used.
+ *
+ * When the module is not used, this macro expands to no code at all.
+ *
+ * @param EVENT The type of the event, one of LZ_TRACE_EVENT_XXX.
+ * @param DATA The data of the event.
+ */
+#define TRACE_POINT(EVENT, DATA)                \
+  do {                                          \
+    if (LZ_CONFIG_MODULE_TRACE_USED) {          \
+      Trace_Record((EVENT), (DATA));            \
+    }                                           \
+  } while (0)
+
+/**
+ * Record an event in the trace from kernel code that runs with interrupts
+ * disabled, if the module "trace" is used.
+ *
+ * It is cheaper than TRACE_POINT(), as the interrupts status is neither saved
+ * nor restored. When the module is not used, this macro expands to no code at
+ * all.
+ *
+ * @param EVENT The type of the event, one of LZ_TRACE_EVENT_XXX.
+ * @param DATA The data of the event.
+ */
+#define TRACE_POINT_INTERRUPTS_DISABLED(EVENT, DATA)    \
+  do {                                                  \
+    if (LZ_CONFIG_MODULE_TRACE_USED) {                  \
+      Trace_RecordInterruptsDisabled((EVENT), (DATA));  \
+    }                                                   \
+  } while (0)
+
+/**
+ * Record an event in the trace.
+ *
+ * Prefer the macro TRACE_POINT() to calling this function directly.
+ *
+ * @param event The type of the event.
+ * @param data The data of the event.
+ */
+void
+Trace_Record(const lz_trace_event_t event, const uint8_t data);
+
+/**
+ * Record an event in the trace, interrupts being already disabled.
+ *
+ * Prefer the macro TRACE_POINT_INTERRUPTS_DISABLED() to calling this function
+ * directly.
+ *
+ * This function must be called with interrupts disabled.
+ *
+ * @param event The type of the event.
+ * @param data The data of the event.
+ */
+void
+Trace_RecordInterruptsDisabled(const lz_trace_event_t event,
+                               const uint8_t data);
+
+/**
+ * Increment the clock tick count of the trace.
+ *
+ * This is to be done at every clock tick.
+ */
+void
+Trace_IncrementTick(void);
+
+/**
+ * Register the kernel task that streams the trace over the serial line, if the
+ * configuration option LZ_CONFIG_TRACE_STREAM is set.
+ *
+ * @return
+ *         - _true_ if the task has been registered without error, or if the
+ *           streaming is not configured.
+ *         - _false_ if an error occurred during registration.
+ */
+bool
+Trace_RegisterStreamTask(void);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_SYS_TRACE_H */
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Kernel events trace user interface.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the user interface of the kernel events trace.
+ * Kernel events are recorded in a ring buffer, that can be drained by a user
+ * task.
+ */
+
+#ifndef LAZULI_TRACE_H
+#define LAZULI_TRACE_H
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+
+_EXTERN_C_DECL_BEGIN
+
+/**
+ * Represents the type of a kernel event recorded in the trace.
+ */
+typedef uint8_t lz_trace_event_t;
+
+/**
+ * A task other than the running one has been elected by the scheduler at a
+ * clock tick, or the first task has been elected when the scheduler started.
+ * The data of the record is the ID of the elected task.
+ */
+#define LZ_TRACE_EVENT_CONTEXT_SWITCH ((lz_trace_event_t)0U)
+
+/**
+ * An interrupt has been handled by the kernel.
+ * The data of the record is the interrupt code, as defined in interrupts.h.
+ */
+#define LZ_TRACE_EVENT_INTERRUPT ((lz_trace_event_t)1U)
+
+/**
+ * A task waiting for an interrupt has been woken up.
+ * The data of the record is the ID of the task.
+ */
+#define LZ_TRACE_EVENT_TASK_WAKEUP ((lz_trace_event_t)2U)
+
+/**
+ * A cyclic real-time task has been activated for a new period.
+ * The data of the record is the ID of the task.
+ */
+#define LZ_TRACE_EVENT_TASK_ACTIVATION ((lz_trace_event_t)3U)
+
+/**
+ * A task has blocked on a locked mutex.
+ * The data of the record is the ID of the task.
+ */
+#define LZ_TRACE_EVENT_MUTEX_BLOCK ((lz_trace_event_t)4U)
+
+/**
+ * A task waiting for a mutex has been woken up.
+ * The data of the record is the ID of the task.
+ */
+#define LZ_TRACE_EVENT_MUTEX_UNBLOCK ((lz_trace_event_t)5U)
+
+/**
+ * The software timer of a task has expired.
+ * The data of the record is the ID of the task.
+ */
+#define LZ_TRACE_EVENT_TIMER_EXPIRY ((lz_trace_event_t)6U)
+
+/**
+ * Represents one record of the trace.
+ */
+typedef struct {
+  /**
+   * The number of clock ticks elapsed since the scheduler started, at the time
+   * of the event. This value wraps around.
+   */
+  uint16_t tick;
+
+  /**
+   * The value of the system timer counter at the time of the event, i.e. the
+   * time elapsed since the last clock tick, in system timer counts.
+   */
+  uint16_t timerCounter;
+
+  /**
+   * The type of the event.
+   */
+  lz_trace_event_t event;
+
+  /**
+   * The data of the event. Its meaning depends on the type of the event.
+   */
+  uint8_t data;
+}Lz_TraceRecord;
+
+/**
+ * Drain records from the trace.
+ *
+ * Records are copied in chronological order, then removed from the trace.
+ *
+ * @param records A pointer to a table of Lz_TraceRecord to fill.
+ * @param maxCount The number of elements of the table @p records.
+ *
+ * @return The number of records copied to @p records.
+ */
+uint8_t
+Lz_Trace_Drain(Lz_TraceRecord * const records, const uint8_t maxCount);
+
+/**
+ * Get the number of records lost because the trace was full.
+ *
+ * When the trace is full, new records overwrite the oldest ones.
+ *
+ * @return The number of records lost since the scheduler started. This value
+ *         wraps around.
+ */
+uint16_t
+Lz_Trace_GetLostRecordsCount(void);
+
+_EXTERN_C_DECL_END
+
+#endif /* LAZULI_TRACE_H */
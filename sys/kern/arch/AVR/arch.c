@@ -68,16 +68,54 @@ Arch_CpuSleep(void)
 void
 Arch_InitInstrumentation(void)
 {
-  if (!LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES) {
-    return;
-  }
-
-  /* Direction of the pin */
+  /* Direction of the pins */
   /* WARNING: This is very specific to the AVR ATmega328p. */
-  SET_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT - 1),
-           uint8_t,
-           POSITION(LZ_CONFIG_AVR_INSTRUMENT_POSITION));
-  CLEAR_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT),
+  if (LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES) {
+    SET_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT - 1),
              uint8_t,
              POSITION(LZ_CONFIG_AVR_INSTRUMENT_POSITION));
+    CLEAR_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT),
+               uint8_t,
+               POSITION(LZ_CONFIG_AVR_INSTRUMENT_POSITION));
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_INTERRUPTS) {
+    SET_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT - 1),
+             uint8_t,
+             POSITION(LZ_CONFIG_AVR_INSTRUMENT_INTERRUPTS_POSITION));
+    CLEAR_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_PORT),
+               uint8_t,
+               POSITION(LZ_CONFIG_AVR_INSTRUMENT_INTERRUPTS_POSITION));
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_TASK_ID) {
+    SET_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT - 1),
+             uint8_t,
+             LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK);
+    CLEAR_BITS(DIRECT(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT),
+               uint8_t,
+               LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK);
+  }
+}
+
+/*
+ * This is executed in the scheduler, with interrupts disabled. So the
+ * read-modify-write of the port is safe. Other pins of the port are left
+ * untouched.
+ * When the whole port is used, this is a single write to the port.
+ */
+void
+Arch_InstrumentTaskId(const uint8_t taskId)
+{
+  const uint8_t mask = LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_MASK;
+  uint8_t otherPins;
+
+  if (UINT8_MAX == mask) {
+    DIRECT(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT) = taskId;
+
+    return;
+  }
+
+  otherPins = DIRECT(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT) & ~mask;
+  DIRECT(LZ_CONFIG_AVR_INSTRUMENT_TASK_ID_PORT) = otherPins | (taskId & mask);
 }
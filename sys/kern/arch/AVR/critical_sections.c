@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Measure of the duration of critical sections.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the implementation of the measure of the time during
+ * which interrupts are disabled.
+ *
+ * A critical section begins when interrupts go from enabled to disabled, and
+ * ends when they go from disabled to enabled. Its beginning and end are
+ * timestamped with the system timer counter. The routines that enable and
+ * disable interrupts, and the interrupt handlers, call the functions of this
+ * file when the configuration option LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS is
+ * set.
+ *
+ * All the functions of this file must be called with interrupts disabled.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+
+#include <Lazuli/sys/arch/AVR/timer_counter_1.h>
+#include <Lazuli/sys/arch/arch.h>
+
+/**
+ * The value of the system timer counter at the beginning of the current
+ * critical section.
+ */
+static uint16_t beginTimerCounter;
+
+/**
+ * The location of the beginning of the current critical section.
+ */
+static uint16_t beginLocation;
+
+/**
+ * The interrupt code of the current critical section.
+ */
+static uint8_t beginInterruptCode;
+
+/**
+ * Indicates if a critical section is currently measured.
+ */
+static bool isInCriticalSection = false;
+
+/**
+ * The longest critical section measured.
+ */
+static Lz_CriticalSection longestCriticalSection = {
+  0,
+  0,
+  LZ_CRITICAL_SECTION_NO_INTERRUPT
+};
+
+/**
+ * @name Kernel API
+ * @{
+ */
+
+void
+Arch_RecordCriticalSectionBegin(const uint16_t location,
+                                const uint8_t interruptCode)
+{
+  beginTimerCounter = TCNT1;
+  beginLocation = location;
+  beginInterruptCode = interruptCode;
+  isInCriticalSection = true;
+}
+
+void
+Arch_RecordCriticalSectionEnd(void)
+{
+  const uint16_t endTimerCounter = TCNT1;
+  uint16_t duration;
+
+  if (!isInCriticalSection) {
+    return;
+  }
+
+  isInCriticalSection = false;
+
+  /*
+   * The timer counter is reset at each clock tick. So if the end is lower than
+   * the beginning, a clock tick occurred during the critical section.
+   */
+  duration = endTimerCounter - beginTimerCounter;
+  if (endTimerCounter < beginTimerCounter) {
+    duration += Arch_GetSystemTimerPeriod();
+  }
+
+  if (duration > longestCriticalSection.duration) {
+    longestCriticalSection.duration = duration;
+    longestCriticalSection.location = beginLocation;
+    longestCriticalSection.interruptCode = beginInterruptCode;
+  }
+}
+
+void
+Arch_GetLongestCriticalSection(Lz_CriticalSection * const criticalSection)
+{
+  criticalSection->duration = longestCriticalSection.duration;
+  criticalSection->location = longestCriticalSection.location;
+  criticalSection->interruptCode = longestCriticalSection.interruptCode;
+}
+
+void
+Arch_ResetLongestCriticalSection(void)
+{
+  longestCriticalSection.duration = 0;
+  longestCriticalSection.location = 0;
+  longestCriticalSection.interruptCode = LZ_CRITICAL_SECTION_NO_INTERRUPT;
+}
+
+/** @} */
@@ -17,6 +17,7 @@
 #include <Lazuli/config.h>
 
 #include <Lazuli/sys/arch/AVR/timer_counter_1.h>
+#include <Lazuli/sys/arch/arch.h>
 
 /** The Timer/Counter 1 clock prescaler */
 #define TIMER_COUNTER_1_PRESCALER (8)
@@ -53,3 +54,30 @@ Arch_StartSystemTimer(void)
   /* Clock select : system clock, prescale by 8 */
   TCCR1B |= TCCR1B_CS11;
 }
+
+uint16_t
+Arch_GetSystemTimerCounter(void)
+{
+  /*
+   * TCNT1 is read through the TEMP register, shared by all 16-bit registers of
+   * the timer. So the read must not be interrupted.
+   */
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+  const uint16_t counter = TCNT1;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return counter;
+}
+
+uint16_t
+Arch_GetSystemTimerPeriod(void)
+{
+  return (uint16_t)(COMPARE_MATCH_REGISTER_VALUE + 1);
+}
+
+bool
+Arch_IsSystemTimerTickPending(void)
+{
+  return 0 != (TIFR1 & TIFR1_OCF1A);
+}
@@ -65,7 +65,9 @@ Kernel_Main(void)
     Arch_InitSerial();
   }
 
-  if (LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES) {
+  if (LZ_CONFIG_INSTRUMENT_CONTEXT_SWITCHES ||
+      LZ_CONFIG_INSTRUMENT_TASK_ID ||
+      LZ_CONFIG_INSTRUMENT_INTERRUPTS) {
     Arch_InitInstrumentation();
   }
 
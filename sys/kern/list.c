@@ -162,6 +162,8 @@ List_InsertAfter(Lz_LinkedList * const linkedList,
 
   if (linkedList->last == listItem) {
     linkedList->last = itemToInsert;
+  } else {
+    listItem->next->prev = itemToInsert;
   }
 
   itemToInsert->next = listItem->next;
@@ -182,6 +184,8 @@ List_InsertBefore(Lz_LinkedList * const linkedList,
 
   if (linkedList->first == listItem) {
     linkedList->first = itemToInsert;
+  } else {
+    listItem->prev->next = itemToInsert;
   }
 
   itemToInsert->next = listItem;
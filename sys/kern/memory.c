@@ -68,15 +68,3 @@ KIncrementalMalloc(const size_t size)
 {
   return SetBreak(size, &kernelAllocationMap);
 }
-
-void
-Memory_Copy(const void *source, void *destination, const size_t size)
-{
-  size_t i;
-  const uint8_t *sourceBytes = source;
-  uint8_t *destinationBytes = destination;
-
-  for (i = 0; i < size; ++i) {
-    destinationBytes[i] = sourceBytes[i];
-  }
-}
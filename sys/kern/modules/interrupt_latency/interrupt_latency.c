@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Interrupt latency measurement implementation.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the implementation of the interrupt latency measurement.
+ *
+ * Latencies are computed from the timestamps of the scheduler, so latencies
+ * longer than one clock tick can be measured.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/interrupt_latency.h>
+
+#include <Lazuli/sys/arch/AVR/interrupts.h>
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/interrupt_latency.h>
+#include <Lazuli/sys/memory.h>
+#include <Lazuli/sys/scheduler.h>
+
+/**
+ * @cond false
+ *
+ * Buckets of the histograms are indexed with 8-bit values, and latencies are
+ * saturated to 16 bits.
+ */
+STATIC_ASSERT(LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE > 0 &&
+              LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE <= UINT8_MAX,
+              LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE_is_out_of_range);
+STATIC_ASSERT(LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT < 16,
+              LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT_is_too_big);
+/** @endcond */
+
+/**
+ * The index of the last bucket of the histograms.
+ */
+#define LAST_BUCKET ((uint8_t)(LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE - 1))
+
+/**
+ * The statistics of latencies for each interrupt.
+ *
+ * This table is indexed by the codes defined in interrupts.h.
+ */
+static Lz_InterruptLatency latencies[INT_TOTAL];
+
+/**
+ * Increment a counter, unless it has reached UINT16_MAX.
+ *
+ * @param counter A pointer to the counter to increment.
+ */
+static void
+IncrementSaturated(uint16_t * const counter)
+{
+  if (UINT16_MAX != *counter) {
+    ++(*counter);
+  }
+}
+
+/**
+ * @name Kernel API
+ * @{
+ */
+
+void
+InterruptLatency_Record(const uint8_t interruptCode, const uint32_t timestamp)
+{
+  InterruptsStatus interruptsStatus;
+  Lz_InterruptLatency *entry;
+  uint32_t latency;
+  uint16_t saturatedLatency;
+  uint8_t bucket;
+
+  if (interruptCode > INT_LAST_ENTRY) {
+    return;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  latency = Scheduler_GetTimestamp() - timestamp;
+  entry = &latencies[interruptCode];
+
+  if (latency > UINT16_MAX) {
+    saturatedLatency = UINT16_MAX;
+  } else {
+    saturatedLatency = (uint16_t)latency;
+  }
+
+  if ((latency >> LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT) > LAST_BUCKET) {
+    bucket = LAST_BUCKET;
+  } else {
+    bucket = (uint8_t)(latency >> LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SHIFT);
+  }
+
+  if (0 == entry->count || saturatedLatency < entry->min) {
+    entry->min = saturatedLatency;
+  }
+
+  if (saturatedLatency > entry->max) {
+    entry->max = saturatedLatency;
+  }
+
+  IncrementSaturated(&entry->count);
+  IncrementSaturated(&entry->histogram[bucket]);
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+/** @} */
+
+/**
+ * @name User API
+ * @{
+ */
+
+bool
+Lz_InterruptLatency_Get(const uint8_t interruptCode,
+                        Lz_InterruptLatency * const latency)
+{
+  InterruptsStatus interruptsStatus;
+
+  if (interruptCode > INT_LAST_ENTRY || NULL == latency) {
+    return false;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  Memory_Copy(&latencies[interruptCode], latency, sizeof(Lz_InterruptLatency));
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return true;
+}
+
+void
+Lz_InterruptLatency_Reset(void)
+{
+  InterruptsStatus interruptsStatus;
+  uint8_t i;
+  uint8_t j;
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  for (i = 0; i < INT_TOTAL; ++i) {
+    latencies[i].count = 0;
+    latencies[i].min = 0;
+    latencies[i].max = 0;
+
+    for (j = 0; j < LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE; ++j) {
+      latencies[i].histogram[j] = 0;
+    }
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+/** @} */
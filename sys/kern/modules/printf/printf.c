@@ -20,13 +20,65 @@
 #include <Lazuli/common.h>
 #include <Lazuli/config.h>
 
+#include <Lazuli/sys/arch/arch.h>
 #include <Lazuli/sys/printf.h>
 
 /** @cond false */
 STATIC_ASSERT(2 == sizeof(unsigned int),
               Sizeof_unsigned_int_not_supported_for_printf);
+
+STATIC_ASSERT(4 == sizeof(unsigned long),
+              Sizeof_unsigned_long_not_supported_for_printf);
 /** @endcond */
 
+/**
+ * Load a character, either from RAM or from program memory.
+ *
+ * @param c A pointer to the character to load.
+ * @param isInProgmem A boolean value indicating if @p c points to program
+ *                    memory.
+ *
+ * @return The character pointed by @p c.
+ */
+static char
+LoadChar(const char * const c, const bool isInProgmem)
+{
+  if (isInProgmem) {
+    return (char)Arch_LoadU8FromProgmem(c);
+  }
+
+  return *c;
+}
+
+/**
+ * Obtain the length of a string stored in RAM or in program memory.
+ *
+ * @param s A pointer to the NUL-terminated string.
+ * @param isInProgmem A boolean value indicating if @p s points to program
+ *                    memory.
+ *
+ * @return The number of characters in the string, or 0 if @p s is NULL.
+ */
+static size_t
+GetStringLength(const char * const s, const bool isInProgmem)
+{
+  size_t length = 0;
+
+  if (!isInProgmem) {
+    return strlen(s);
+  }
+
+  if (NULL == s) {
+    return 0;
+  }
+
+  while ('\0' != LoadChar(s + length, true)) {
+    ++length;
+  }
+
+  return length;
+}
+
 /**
  * Convert a base 16 unit value to its hexadecimal digit representation.
  * The value must be <= 15.
@@ -54,67 +106,56 @@ GetHexDigit(const uint8_t i, const bool isUpper)
 }
 
 /**
- * Convert an unsigned 16-bit integer to its ASCII hexadecimal representation.
+ * Convert an unsigned 32-bit integer to its ASCII hexadecimal representation.
  * @warning The conversion is put in the buffer @p buffer **in reverse order**
  * and **without a final NUL character**. The caller of this function then has
  * to use the return value in order to use the characters in the buffer in the
  * right order.
  *
- * @param value The 16-bit input value to convert.
- * @param buffer A valid pointer to an allocated buffer of minimum size 4 chars.
+ * @param value The 32-bit input value to convert.
+ * @param buffer A valid pointer to an allocated buffer of minimum size 8 chars.
  * @param isUpper A boolean value indicating if the conversion must be done in
  *                uppercase.
  *
  * @return The number of characters actually written to the buffer.
  */
 static uint8_t
-ConvertU16ToHexadecimal(uint16_t value, char * const buffer, const bool isUpper)
+ConvertU32ToHexadecimal(uint32_t value, char * const buffer, const bool isUpper)
 {
-  uint8_t i;
-  const uint8_t numberOfNibbles = sizeof(value) * 2;
+  uint8_t i = 0;
 
-  /* WARNING! This works only with little endian */
-  for (i = 0; i < numberOfNibbles; ++i) {
-    buffer[i] = GetHexDigit(value & 0xfU, isUpper);
+  do {
+    buffer[i++] = GetHexDigit((uint8_t)value & 0xfU, isUpper);
     value >>= 4U;
+  } while (0 != value);
 
-    if (0 == value) {
-      break;
-    }
-  }
-
-  return i + 1;
+  return i;
 }
 
 /**
- * Convert an unsigned 16-bit integer to its ASCII octal representation.
+ * Convert an unsigned 32-bit integer to its ASCII octal representation.
  * @warning The conversion is put in the buffer @p buffer **in reverse order**
  * and **without a final NUL character**. The caller of this function then has
  * to use the return value in order to use the characters in the buffer in the
  * right order.
  *
- * @param value The 16-bit input value to convert.
- * @param buffer A valid pointer to an allocated buffer of minimum size 6 chars.
+ * @param value The 32-bit input value to convert.
+ * @param buffer A valid pointer to an allocated buffer of minimum size 11
+ *               chars.
  *
  * @return The number of characters actually written to the buffer.
  */
 static uint8_t
-ConvertU16ToOctal(uint16_t value, char * const buffer)
+ConvertU32ToOctal(uint32_t value, char * const buffer)
 {
-  uint8_t i;
-  const uint8_t numberOfGroups = 6;
+  uint8_t i = 0;
 
-  /* WARNING! This works only with little endian */
-  for (i = 0; i < numberOfGroups; ++i) {
-    buffer[i] = (char)((value & 07U) + '0');
+  do {
+    buffer[i++] = (char)(((uint8_t)value & 07U) + '0');
     value >>= 3U;
+  } while (0 != value);
 
-    if (0 == value) {
-      break;
-    }
-  }
-
-  return i + 1;
+  return i;
 }
 
 /**
@@ -158,14 +199,18 @@ OutputPadding(uint8_t padLength,
  *
  * @param buffer A valid pointer to the buffer.
  * @param size The size of the buffer.
+ * @param isInProgmem A boolean value indicating if @p buffer points to program
+ *                    memory.
  */
 static void
-OutputBuffer(const char * const buffer, const uint8_t size)
+OutputBuffer(const char * const buffer,
+             const uint8_t size,
+             const bool isInProgmem)
 {
   uint8_t i;
 
   for (i = 0; i < size; ++i) {
-    putchar(buffer[i]);
+    putchar(LoadChar(buffer + i, isInProgmem));
   }
 }
 
@@ -183,35 +228,44 @@ OutputReverseBuffer(const char * const buffer, uint8_t size)
   }
 }
 
-/*
+/**
+ * Produce formatted output to the serial line.
+ *
+ * This is the common implementation of printf() and printf_P().
+ *
+ * @param format The format string.
+ * @param args The variadic parameters.
+ * @param isInProgmem A boolean value indicating if the format string, and the
+ *                    strings of the "%s" conversions, are stored in program
+ *                    memory.
+ *
+ * @return The number of characters output to the serial line.
+ *
  * Warning! The stack usage of this function is important! Reduce the stack
  * usage to its strict minimum.
  */
-int
-printf(const char *format, ...)
+static int
+PrintFormatted(const char * const format,
+               va_list args,
+               const bool isInProgmem)
 {
-  va_list args;
   int total = 0;
   const char *c = format;
+  char current;
 
-  if (NULL == format) {
-    return 0;
-  }
-
-  va_start(args, format);
-
-  for (; '\0' != *c; ++c) {
-    if ('%' == *c) {
+  for (; '\0' != (current = LoadChar(c, isInProgmem)); ++c) {
+    if ('%' == current) {
       int size;
       int padLength = 0;
       char padChar = ' ';
       bool firstDigitPassed = false;
       bool isNegative = false;
       bool rightPadded = false;
-      char buffer[6];
+      bool isLong = false;
+      char buffer[11];
       const char *s = buffer;
 
-      for (++c; '\0' != *c; ++c) {
+      for (++c; '\0' != (current = LoadChar(c, isInProgmem)); ++c) {
         /*
          * First, we parse formatting characters.
          * After a formatting character, we must continue to parse in the
@@ -219,21 +273,25 @@ printf(const char *format, ...)
          */
 
         /* This test MUST be performed before the next one */
-        if ('0' == *c && !firstDigitPassed) {
+        if ('0' == current && !firstDigitPassed) {
           padChar = '0';
           firstDigitPassed = true;
 
           continue;
-        } else if (*c >= '0' && *c <= '9') {
-          padLength = padLength * 10 + *c - '0';
+        } else if (current >= '0' && current <= '9') {
+          padLength = padLength * 10 + current - '0';
           firstDigitPassed = true;
 
           continue;
-        } else if ('-' == *c) {
+        } else if ('-' == current) {
           rightPadded = true;
 
           continue;
-        } else if ('%' == *c) { /*
+        } else if ('l' == current) {
+          isLong = true;
+
+          continue;
+        } else if ('%' == current) { /*
                                  * Then we parse "terminating characters".
                                  * After a terminating character, we must exit
                                  * the current loop.
@@ -243,43 +301,61 @@ printf(const char *format, ...)
           putchar('%');
 
           break;
-        } else if ('d' == *c || 'i' == *c || 'u' == *c) {
-          unsigned int absolute;
-
-          if ('u' == *c) {
-            absolute = va_arg(args, unsigned int);
+        } else if ('d' == current || 'i' == current || 'u' == current) {
+          if (isLong) {
+            unsigned long absolute;
+
+            if ('u' == current) {
+              absolute = va_arg(args, unsigned long);
+            } else {
+              const long value = va_arg(args, long);
+              isNegative = value < 0;
+              absolute = ABS(value);
+            }
+
+            size = Printf_ConvertU32ToDecimal(absolute, buffer);
           } else {
-            const int value = va_arg(args, int);
-            isNegative = value < 0;
-            absolute = ABS(value);
+            unsigned int absolute;
+
+            if ('u' == current) {
+              absolute = va_arg(args, unsigned int);
+            } else {
+              const int value = va_arg(args, int);
+              isNegative = value < 0;
+              absolute = ABS(value);
+            }
+
+            if (2 == sizeof(unsigned int)) {
+              size = Printf_ConvertU16ToDecimal(absolute, buffer);
+            } else {
+              /*
+               * Add here the support for another sizeof(unsigned int).
+               *
+               * Remember to:
+               * - Change the size of 'buffer'.
+               * - Add the new sizeof(unsigned int) in the STATIC_ASSERT.
+               */
+            }
           }
-
-          if (2 == sizeof(unsigned int)) {
-            size = Printf_ConvertU16ToDecimal(absolute, buffer);
-          } else {
-            /*
-             * Add here the support for another sizeof(unsigned int).
-             *
-             * Remember to:
-             * - Change the size of 'buffer'.
-             * - Add the new sizeof(unsigned int) in the STATIC_ASSERT.
-             * - Perform the same test on sizeof() for hexadecimal and octal
-             *   conversions.
-             */
-          }
-        } else if ('x' == *c || 'X' == *c) {
-          size = ConvertU16ToHexadecimal(va_arg(args, unsigned int),
-                                         buffer,
-                                         'X' == *c);
-        } else if ('o' == *c) {
-          size = ConvertU16ToOctal(va_arg(args, unsigned int), buffer);
-        } else if ('c' == *c) {
+        } else if ('x' == current || 'X' == current) {
+          const uint32_t value = isLong
+            ? va_arg(args, unsigned long)
+            : va_arg(args, unsigned int);
+
+          size = ConvertU32ToHexadecimal(value, buffer, 'X' == current);
+        } else if ('o' == current) {
+          const uint32_t value = isLong
+            ? va_arg(args, unsigned long)
+            : va_arg(args, unsigned int);
+
+          size = ConvertU32ToOctal(value, buffer);
+        } else if ('c' == current) {
           buffer[0] = (char)va_arg(args, int);
           size = 1;
-        } else if ('s' == *c) {
+        } else if ('s' == current) {
           padChar = ' '; /* For strings, we always pad with spaces */
           s = va_arg(args, char*);
-          size = strlen(s);
+          size = GetStringLength(s, isInProgmem);
         } else {
           /*
            * We encountered an unknown character.
@@ -310,8 +386,8 @@ printf(const char *format, ...)
             ++total;
           }
 
-          if ('s' == *c) {
-            OutputBuffer(s, size);
+          if ('s' == current) {
+            OutputBuffer(s, size, isInProgmem);
           } else {
             OutputReverseBuffer(s, size);
           }
@@ -338,8 +414,8 @@ printf(const char *format, ...)
             ++total;
           }
 
-          if ('s' == *c) {
-            OutputBuffer(s, size);
+          if ('s' == current) {
+            OutputBuffer(s, size, isInProgmem);
           } else {
             OutputReverseBuffer(s, size);
           }
@@ -349,10 +425,42 @@ printf(const char *format, ...)
       }
     } else {
       ++total;
-      putchar(*c);
+      putchar(current);
     }
   }
 
+  return total;
+}
+
+int
+printf(const char *format, ...)
+{
+  va_list args;
+  int total;
+
+  if (NULL == format) {
+    return 0;
+  }
+
+  va_start(args, format);
+  total = PrintFormatted(format, args, false);
+  va_end(args);
+
+  return total;
+}
+
+int
+printf_P(const char *format, ...)
+{
+  va_list args;
+  int total;
+
+  if (NULL == format) {
+    return 0;
+  }
+
+  va_start(args, format);
+  total = PrintFormatted(format, args, true);
   va_end(args);
 
   return total;
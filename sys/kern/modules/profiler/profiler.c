@@ -0,0 +1,196 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Statistical profiler implementation.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the implementation of the statistical profiler.
+ *
+ * Samples are counted in an open addressing hash table, with linear probing.
+ * An entry is free when its count is 0. Entries are never removed, except when
+ * the whole table is reset, so the probing sequence never has holes.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/profiler.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/compiler.h>
+#include <Lazuli/sys/memory.h>
+#include <Lazuli/sys/profiler.h>
+
+/**
+ * The mask used to wrap indexes of the hash table.
+ */
+#define PROFILER_TABLE_MASK ((uint8_t)(LZ_CONFIG_PROFILER_TABLE_SIZE - 1))
+
+/**
+ * @cond false
+ *
+ * The indexes of the hash table are wrapped with a mask, and are 8-bit
+ * counters.
+ */
+STATIC_ASSERT(0 == (LZ_CONFIG_PROFILER_TABLE_SIZE & PROFILER_TABLE_MASK),
+              LZ_CONFIG_PROFILER_TABLE_SIZE_must_be_a_power_of_2);
+STATIC_ASSERT(LZ_CONFIG_PROFILER_TABLE_SIZE <= 128,
+              LZ_CONFIG_PROFILER_TABLE_SIZE_must_be_at_most_128);
+/** @endcond */
+
+/**
+ * The hash table of samples.
+ */
+static Lz_ProfilerSample samplesTable[LZ_CONFIG_PROFILER_TABLE_SIZE];
+
+/**
+ * The number of samples lost because the hash table was full.
+ */
+static uint16_t lostSamplesCount = 0;
+
+/**
+ * Compute the index in the hash table of a program counter for a task.
+ *
+ * @param taskId The ID of the task.
+ * @param pc The program counter.
+ *
+ * @return The index of the first entry to probe.
+ */
+static uint8_t
+Hash(const uint8_t taskId, const uint16_t pc)
+{
+  /*
+   * The low bits of the program counter are the ones that vary the most. The
+   * task ID is multiplied by an odd constant to spread its bits.
+   */
+  return LO8(pc) ^ HI8(pc) ^ (uint8_t)(taskId * 0x9DU);
+}
+
+/**
+ * Count one sample in the hash table.
+ *
+ * This function must be called with interrupts disabled.
+ *
+ * @param taskId The ID of the task that was running.
+ * @param pc The sampled program counter.
+ */
+static void
+CountSample(const uint8_t taskId, const uint16_t pc)
+{
+  const uint8_t hash = Hash(taskId, pc);
+  Lz_ProfilerSample *entry;
+  uint8_t i;
+
+  for (i = 0; i < LZ_CONFIG_PROFILER_TABLE_SIZE; ++i) {
+    entry = &samplesTable[(uint8_t)(hash + i) & PROFILER_TABLE_MASK];
+
+    if (0 == entry->count) {
+      entry->pc = pc;
+      entry->taskId = taskId;
+      entry->count = 1;
+
+      return;
+    }
+
+    if (pc == entry->pc && taskId == entry->taskId) {
+      if (UINT16_MAX != entry->count) {
+        ++entry->count;
+      }
+
+      return;
+    }
+  }
+
+  if (UINT16_MAX != lostSamplesCount) {
+    ++lostSamplesCount;
+  }
+}
+
+/**
+ * @name Kernel API
+ * @{
+ */
+
+void
+Profiler_Sample(const uint8_t taskId, const uint16_t pc)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  CountSample(taskId, pc);
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+/** @} */
+
+/**
+ * @name User API
+ * @{
+ */
+
+uint8_t
+Lz_Profiler_GetSamples(Lz_ProfilerSample * const samples,
+                       const uint8_t maxCount,
+                       uint8_t * const cursor)
+{
+  InterruptsStatus interruptsStatus;
+  uint8_t count = 0;
+  uint8_t i;
+
+  if (NULL == samples || NULL == cursor) {
+    return 0;
+  }
+
+  /*
+   * Interrupts are disabled for each entry only, to keep the interrupts
+   * latency low.
+   */
+  for (i = *cursor; i < LZ_CONFIG_PROFILER_TABLE_SIZE && count < maxCount;
+       ++i) {
+    interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+    if (0 != samplesTable[i].count) {
+      Memory_Copy(&samplesTable[i], &samples[count], sizeof(Lz_ProfilerSample));
+      ++count;
+    }
+
+    Arch_RestoreInterruptsStatus(interruptsStatus);
+  }
+
+  *cursor = i;
+
+  return count;
+}
+
+uint16_t
+Lz_Profiler_GetLostSamplesCount(void)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+  const uint16_t count = lostSamplesCount;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return count;
+}
+
+void
+Lz_Profiler_Reset(void)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+  uint8_t i;
+
+  for (i = 0; i < LZ_CONFIG_PROFILER_TABLE_SIZE; ++i) {
+    samplesTable[i].count = 0;
+  }
+
+  lostSamplesCount = 0;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+/** @} */
@@ -70,6 +70,23 @@ puts(const char * s)
   return 1;
 }
 
+int
+puts_P(const char * s)
+{
+  char c;
+
+  if (NULL == s) {
+    return EOF;
+  }
+
+  while ('\0' != (c = (char)Arch_LoadU8FromProgmem(s))) {
+    putchar(c);
+    ++s;
+  }
+
+  return puts("");
+}
+
 /**
  * Retrieve the enabling status of the serial line.
  *
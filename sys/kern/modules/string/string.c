@@ -10,6 +10,8 @@
  *
  * This file contains the implementation of various functions declared by the
  * standard header <string.h>.
+ * Other functions are implemented in ASM, in the architecture-specific part of
+ * this module.
  */
 
 #include <string.h>
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Kernel events trace implementation.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the implementation of the kernel events trace.
+ *
+ * Records are stored in a ring buffer whose size is a power of 2, so indexes
+ * can be wrapped with a simple mask. The read and write indexes are free
+ * running 8-bit counters: their difference is always the number of records
+ * stored in the ring buffer.
+ */
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/trace.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/compiler.h>
+#include <Lazuli/sys/memory.h>
+#include <Lazuli/sys/trace.h>
+
+/**
+ * The mask used to wrap indexes of the ring buffer.
+ */
+#define TRACE_BUFFER_MASK ((uint8_t)(LZ_CONFIG_TRACE_BUFFER_SIZE - 1))
+
+/**
+ * @cond false
+ *
+ * The indexes of the ring buffer are wrapped with a mask, and are free running
+ * 8-bit counters.
+ */
+STATIC_ASSERT(0 == (LZ_CONFIG_TRACE_BUFFER_SIZE & TRACE_BUFFER_MASK),
+              LZ_CONFIG_TRACE_BUFFER_SIZE_must_be_a_power_of_2);
+STATIC_ASSERT(LZ_CONFIG_TRACE_BUFFER_SIZE <= 128,
+              LZ_CONFIG_TRACE_BUFFER_SIZE_must_be_at_most_128);
+/** @endcond */
+
+/**
+ * The ring buffer of records.
+ */
+static NOINIT Lz_TraceRecord traceBuffer[LZ_CONFIG_TRACE_BUFFER_SIZE];
+
+/**
+ * The index of the next record to write.
+ */
+static uint8_t writeIndex = 0;
+
+/**
+ * The index of the next record to read.
+ */
+static uint8_t readIndex = 0;
+
+/**
+ * The number of clock ticks elapsed since the scheduler started.
+ */
+static uint16_t tick = 0;
+
+/**
+ * The number of records lost because the ring buffer was full.
+ */
+static uint16_t lostRecordsCount = 0;
+
+/**
+ * @name Kernel API
+ * @{
+ */
+
+void
+Trace_Record(const lz_trace_event_t event, const uint8_t data)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  Trace_RecordInterruptsDisabled(event, data);
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+void
+Trace_RecordInterruptsDisabled(const lz_trace_event_t event,
+                               const uint8_t data)
+{
+  Lz_TraceRecord * const record = &traceBuffer[writeIndex & TRACE_BUFFER_MASK];
+
+  record->tick = tick;
+  record->timerCounter = Arch_GetSystemTimerCounter();
+  record->event = event;
+  record->data = data;
+
+  ++writeIndex;
+
+  /* When the ring buffer is full, we overwrite the oldest record */
+  if ((uint8_t)(writeIndex - readIndex) > LZ_CONFIG_TRACE_BUFFER_SIZE) {
+    ++readIndex;
+    ++lostRecordsCount;
+  }
+}
+
+void
+Trace_IncrementTick(void)
+{
+  ++tick;
+}
+
+/** @} */
+
+/**
+ * @name User API
+ * @{
+ */
+
+uint8_t
+Lz_Trace_Drain(Lz_TraceRecord * const records, const uint8_t maxCount)
+{
+  InterruptsStatus interruptsStatus;
+  uint8_t count;
+
+  if (NULL == records) {
+    return 0;
+  }
+
+  /*
+   * Interrupts are disabled for each record only, to keep the interrupts
+   * latency low.
+   */
+  for (count = 0; count < maxCount; ++count) {
+    interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+    if (readIndex == writeIndex) {
+      Arch_RestoreInterruptsStatus(interruptsStatus);
+
+      break;
+    }
+
+    Memory_Copy(&traceBuffer[readIndex & TRACE_BUFFER_MASK],
+                &records[count],
+                sizeof(Lz_TraceRecord));
+    ++readIndex;
+
+    Arch_RestoreInterruptsStatus(interruptsStatus);
+  }
+
+  return count;
+}
+
+uint16_t
+Lz_Trace_GetLostRecordsCount(void)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+  const uint16_t count = lostRecordsCount;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return count;
+}
+
+/** @} */
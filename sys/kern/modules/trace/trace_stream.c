@@ -0,0 +1,353 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Streaming of the kernel events trace over the serial line.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file describes the implementation of the kernel task that continuously
+ * drains the kernel events trace and sends it over the serial line.
+ *
+ * Each record is sent in its own frame. The payload of a frame starts with a
+ * type byte:
+ *
+ * - 0x00 to 0x7F: a record. The type is the event of the record, followed by
+ *   the data byte, the tick delta and the timestamp. If the tick delta is 0,
+ *   the timestamp is the delta of the timer counter with the previous record,
+ *   else it's the absolute value of the timer counter. Tick delta and timestamp
+ *   are encoded as unsigned LEB128 variable length integers.
+ * - 0x80: a synchronization frame, giving the absolute tick and timer counter
+ *   of the next record, and the period of the clock tick in timer counts. All
+ *   as 16-bit little-endian integers.
+ * - 0x81: some records have been lost. Followed by the number of lost records,
+ *   as an unsigned LEB128 variable length integer.
+ *
+ * In binary mode, frames are delimited with SLIP (RFC 1055) framing. In
+ * hexadecimal mode, each frame is sent as a line of hexadecimal digits.
+ *
+ * The decoder is scripts/trace_decode.py.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/lazuli.h>
+#include <Lazuli/serial.h>
+#include <Lazuli/trace.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/compiler.h>
+#include <Lazuli/sys/trace.h>
+
+/** SLIP frame delimiter */
+#define SLIP_END ((uint8_t)0xC0U)
+
+/** SLIP escape byte */
+#define SLIP_ESC ((uint8_t)0xDBU)
+
+/** SLIP escaped frame delimiter */
+#define SLIP_ESC_END ((uint8_t)0xDCU)
+
+/** SLIP escaped escape byte */
+#define SLIP_ESC_ESC ((uint8_t)0xDDU)
+
+/** Type of the synchronization frame */
+#define FRAME_TYPE_SYNC ((uint8_t)0x80U)
+
+/** Type of the lost records frame */
+#define FRAME_TYPE_LOST ((uint8_t)0x81U)
+
+/** The maximum size of a frame payload, before escaping */
+#define FRAME_MAX_SIZE (8)
+
+/** The number of records between 2 synchronization frames */
+#define SYNC_INTERVAL ((uint8_t)32U)
+
+/** The number of records drained from the trace at once */
+#define DRAIN_COUNT (4)
+
+/**
+ * @cond false
+ *
+ * The streaming task sends data on the serial line.
+ */
+STATIC_ASSERT(!LZ_CONFIG_TRACE_STREAM || LZ_CONFIG_MODULE_SERIAL_USED,
+              Trace_streaming_needs_module_SERIAL);
+/** @endcond */
+
+/**
+ * The tick of the last record sent.
+ */
+static uint16_t previousTick = 0;
+
+/**
+ * The timer counter of the last record sent.
+ */
+static uint16_t previousTimerCounter = 0;
+
+/**
+ * The number of records to send until the next synchronization frame.
+ */
+static uint8_t recordsUntilSync = 0;
+
+/**
+ * The number of lost records already reported in the stream.
+ */
+static uint16_t reportedLostRecordsCount = 0;
+
+/**
+ * Encode an unsigned integer as a LEB128 variable length integer.
+ *
+ * @param value The value to encode.
+ * @param buffer A pointer to the buffer where to write the encoded value. The
+ *               buffer must be at least 3 bytes long.
+ *
+ * @return The number of bytes written to @p buffer.
+ */
+static uint8_t
+EncodeVarint(uint16_t value, uint8_t * const buffer)
+{
+  uint8_t size = 0;
+
+  while (value >= 0x80) {
+    buffer[size++] = (uint8_t)value | 0x80;
+    value >>= 7;
+  }
+
+  buffer[size++] = (uint8_t)value;
+
+  return size;
+}
+
+/**
+ * Encode a 16-bit value in little-endian order.
+ *
+ * @param value The value to encode.
+ * @param buffer A pointer to the buffer where to write the encoded value.
+ *
+ * @return The number of bytes written to @p buffer.
+ */
+static uint8_t
+EncodeU16(const uint16_t value, uint8_t * const buffer)
+{
+  buffer[0] = LO8(value);
+  buffer[1] = HI8(value);
+
+  return sizeof(value);
+}
+
+/**
+ * Encode a synchronization frame, giving the absolute timestamp of a record.
+ *
+ * @param record A pointer to the record to synchronize with.
+ * @param frame A pointer to the buffer where to write the frame payload.
+ *
+ * @return The size of the frame payload.
+ */
+static uint8_t
+EncodeSync(const Lz_TraceRecord * const record, uint8_t * const frame)
+{
+  uint8_t size = 0;
+
+  frame[size++] = FRAME_TYPE_SYNC;
+  size += EncodeU16(record->tick, &frame[size]);
+  size += EncodeU16(record->timerCounter, &frame[size]);
+  size += EncodeU16(Arch_GetSystemTimerPeriod(), &frame[size]);
+
+  previousTick = record->tick;
+  previousTimerCounter = record->timerCounter;
+
+  return size;
+}
+
+/**
+ * Encode a record, with its timestamp delta-encoded from the previous record.
+ *
+ * @param record A pointer to the record to encode.
+ * @param frame A pointer to the buffer where to write the frame payload.
+ *
+ * @return The size of the frame payload.
+ */
+static uint8_t
+EncodeRecord(const Lz_TraceRecord * const record, uint8_t * const frame)
+{
+  const uint16_t deltaTick = record->tick - previousTick;
+  uint8_t size = 0;
+
+  frame[size++] = record->event;
+  frame[size++] = record->data;
+  size += EncodeVarint(deltaTick, &frame[size]);
+
+  if (0 == deltaTick) {
+    size += EncodeVarint(record->timerCounter - previousTimerCounter,
+                         &frame[size]);
+  } else {
+    size += EncodeVarint(record->timerCounter, &frame[size]);
+  }
+
+  previousTick = record->tick;
+  previousTimerCounter = record->timerCounter;
+
+  return size;
+}
+
+/**
+ * Encode a lost records frame.
+ *
+ * @param count The number of lost records.
+ * @param frame A pointer to the buffer where to write the frame payload.
+ *
+ * @return The size of the frame payload.
+ */
+static uint8_t
+EncodeLost(const uint16_t count, uint8_t * const frame)
+{
+  frame[0] = FRAME_TYPE_LOST;
+
+  return 1 + EncodeVarint(count, &frame[1]);
+}
+
+/**
+ * Send a frame on the serial line.
+ *
+ * @param frame A pointer to the frame payload.
+ * @param size The size of the frame payload.
+ */
+static void
+SendFrame(const uint8_t * const frame, const uint8_t size)
+{
+  static PROGMEM const char hexDigits[] = "0123456789ABCDEF";
+  uint8_t i;
+
+  if (LZ_CONFIG_TRACE_STREAM_HEX) {
+    for (i = 0; i < size; ++i) {
+      putchar(Arch_LoadU8FromProgmem(&hexDigits[frame[i] >> 4]));
+      putchar(Arch_LoadU8FromProgmem(&hexDigits[frame[i] & 0x0F]));
+    }
+
+    puts("");
+
+    return;
+  }
+
+  for (i = 0; i < size; ++i) {
+    if (SLIP_END == frame[i]) {
+      putchar(SLIP_ESC);
+      putchar(SLIP_ESC_END);
+    } else if (SLIP_ESC == frame[i]) {
+      putchar(SLIP_ESC);
+      putchar(SLIP_ESC_ESC);
+    } else {
+      putchar(frame[i]);
+    }
+  }
+
+  putchar(SLIP_END);
+}
+
+/**
+ * Send a record on the serial line, preceded by a synchronization frame when
+ * needed.
+ *
+ * @param record A pointer to the record to send.
+ */
+static void
+SendRecord(const Lz_TraceRecord * const record)
+{
+  uint8_t frame[FRAME_MAX_SIZE];
+
+  if (0 == recordsUntilSync) {
+    SendFrame(frame, EncodeSync(record, frame));
+    recordsUntilSync = SYNC_INTERVAL;
+  }
+
+  --recordsUntilSync;
+
+  SendFrame(frame, EncodeRecord(record, frame));
+}
+
+/**
+ * Report the records lost since the last report, if any.
+ */
+static void
+SendLostRecordsCount(void)
+{
+  const uint16_t lostRecordsCount = Lz_Trace_GetLostRecordsCount();
+  uint8_t frame[FRAME_MAX_SIZE];
+
+  if (lostRecordsCount != reportedLostRecordsCount) {
+    SendFrame(frame,
+              EncodeLost(lostRecordsCount - reportedLostRecordsCount, frame));
+    reportedLostRecordsCount = lostRecordsCount;
+  }
+}
+
+/**
+ * The trace streaming task.
+ *
+ * Drains the trace and sends the records on the serial line. When the trace is
+ * empty, the task waits for the next time slice.
+ */
+static void
+TraceStreamTask(void)
+{
+  Lz_TraceRecord records[DRAIN_COUNT];
+  Lz_SerialConfiguration serialConfiguration;
+  uint8_t count;
+  uint8_t i;
+
+  /* The speed of the serial line is left to the user */
+  Lz_Serial_GetConfiguration(&serialConfiguration);
+  serialConfiguration.enableFlags |= LZ_SERIAL_ENABLE_TRANSMIT;
+  Lz_Serial_SetConfiguration(&serialConfiguration);
+
+  if (!LZ_CONFIG_TRACE_STREAM_HEX) {
+    /* Flush any noise on the line */
+    putchar(SLIP_END);
+  }
+
+  for (;;) {
+    count = Lz_Trace_Drain(records, DRAIN_COUNT);
+
+    if (0 == count) {
+      Lz_WaitTimer(1);
+    } else {
+      SendLostRecordsCount();
+
+      for (i = 0; i < count; ++i) {
+        SendRecord(&records[i]);
+      }
+    }
+  }
+}
+
+/**
+ * @name Kernel API
+ * @{
+ */
+
+bool
+Trace_RegisterStreamTask(void)
+{
+  Lz_TaskConfiguration taskConfiguration;
+
+  if (!LZ_CONFIG_TRACE_STREAM) {
+    return true;
+  }
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "trace-stream";
+  taskConfiguration.stackSize = LZ_CONFIG_TRACE_STREAM_TASK_STACK_SIZE;
+  taskConfiguration.schedulingPolicy = PRIORITY_RT;
+  /* The lowest priority */
+  taskConfiguration.priority = INT8_MAX;
+
+  return Lz_RegisterTask(TraceStreamTask, &taskConfiguration);
+}
+
+/** @} */
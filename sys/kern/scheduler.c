@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <Lazuli/basic_task.h>
 #include <Lazuli/common.h>
 #include <Lazuli/config.h>
 #include <Lazuli/lazuli.h>
@@ -23,9 +24,12 @@
 #include <Lazuli/sys/arch/arch.h>
 #include <Lazuli/sys/clock_24.h>
 #include <Lazuli/sys/compiler.h>
+#include <Lazuli/sys/interrupt_latency.h>
 #include <Lazuli/sys/kernel.h>
 #include <Lazuli/sys/memory.h>
+#include <Lazuli/sys/profiler.h>
 #include <Lazuli/sys/scheduler.h>
+#include <Lazuli/sys/trace.h>
 
 /**
  * A pointer to the current running task.
@@ -72,6 +76,72 @@ static Lz_LinkedList terminatedTasks = LINKED_LIST_INIT;
  */
 static Lz_LinkedList abortedTasks = LINKED_LIST_INIT;
 
+/**
+ * The queue of priority tasks that have consumed their CPU budget, and wait for
+ * its replenishment.
+ */
+static Lz_LinkedList throttledTasks = LINKED_LIST_INIT;
+
+/**
+ * The queue of all registered tasks, in their order of registration.
+ *
+ * Tasks are linked in this queue by their member registeredTasksQueue, so they
+ * can be enumerated whatever their state.
+ */
+static Lz_LinkedList registeredTasks = LINKED_LIST_INIT;
+
+/**
+ * The number of registered tasks. Used to attribute task identifiers.
+ */
+static uint8_t registeredTasksCount = 0;
+
+/**
+ * The value of the system timer counter when the current task went to sleep
+ * until the end of its time slice. Only meaningful if isSleepTimestampSet is
+ * _true_, as 0 is a valid value of the counter.
+ */
+static uint16_t sleepTimestamp;
+
+/**
+ * Indicates that the current task went to sleep until the end of its time
+ * slice, and that sleepTimestamp holds the time at which it did.
+ */
+static bool isSleepTimestampSet = false;
+
+/**
+ * Indicates if the timestamps of the kernel are needed, so they are maintained
+ * at each clock tick.
+ */
+#define TIMESTAMPS_USED                         \
+  (LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED ||   \
+   LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS)
+
+/**
+ * The time base of the timestamps, i.e. the timestamp of the last clock tick.
+ */
+static uint32_t timestampBase = 0;
+
+/**
+ * The number of clock ticks since the scheduler started.
+ */
+static uint32_t ticksCount = 0;
+
+/**
+ * The number of clock ticks that switched to a different task.
+ */
+static uint32_t contextSwitchesCount = 0;
+
+/**
+ * The number of time slices given to the idle task.
+ */
+static uint32_t idleTicksCount = 0;
+
+/**
+ * The number of times each interrupt has been handled.
+ * This table is indexed by the codes defined in interrupts.h.
+ */
+static uint16_t interruptsCounts[INT_TOTAL];
+
 /**
  * The idle task.
  *
@@ -79,6 +149,12 @@ static Lz_LinkedList abortedTasks = LINKED_LIST_INIT;
  */
 static NOINIT Task *idleTask;
 
+/**
+ * The size in bytes of the guard placed below the stack of each task.
+ */
+#define STACK_GUARD_SIZE                                  \
+  (LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW ? sizeof(uint16_t) : 0)
+
 /**
  * Contains default values for Lz_TaskConfiguration.
  */
@@ -88,9 +164,104 @@ static PROGMEM const Lz_TaskConfiguration DefaultTaskConfiguration = {
   PRIORITY_RT                       /**< member: schedulingPolicy */,
   0                                 /**< member: priority         */,
   0                                 /**< member: period           */,
-  0                                 /**< member: completion       */
+  0                                 /**< member: completion       */,
+  0                                 /**< member: deadline         */,
+  0                                 /**< member: offset           */,
+  0                                 /**< member: budget           */,
+  1                                 /**< member: quantum          */
 };
 
+/**
+ * The schedule table of the time-triggered scheduler, in program memory.
+ */
+static const uint8_t *scheduleTable = NULL;
+
+/**
+ * The number of slots of the schedule table.
+ */
+static uint16_t scheduleTableLength = 0;
+
+/**
+ * The slot of the schedule table of the current time slice.
+ */
+static uint16_t scheduleSlot = 0;
+
+/**
+ * The registered tasks indexed by ID, for the time-triggered scheduler.
+ */
+static Task **tasksById;
+
+/**
+ * The priority tasks that have a CPU budget.
+ */
+static Task **budgetedTasks;
+
+/**
+ * The timestamp of the interrupt that woke up each task waiting for an
+ * interrupt, indexed by task ID. Used to measure interrupt latency.
+ */
+static uint32_t *interruptTimestamps;
+
+/**
+ * The CPU time consumed by each task since the scheduler started (or since the
+ * last reset of the counters), expressed in system timer counts, and indexed
+ * by task ID. Updated by the scheduler at each clock tick.
+ */
+static uint32_t *cpuTimes;
+
+/**
+ * The number of elements of budgetedTasks.
+ */
+static uint8_t budgetedTasksCount = 0;
+
+/**
+ * The task running basic tasks, on its stack.
+ */
+static Task *basicTasksExecutive = NULL;
+
+/**
+ * The basic tasks activated and not started yet, ordered by priority.
+ */
+static Lz_LinkedList pendingBasicTasks = LINKED_LIST_INIT;
+
+/**
+ * The basic tasks activated periodically.
+ */
+static Lz_LinkedList periodicBasicTasks = LINKED_LIST_INIT;
+
+/**
+ * The basic tasks activated by an interrupt.
+ */
+static Lz_LinkedList interruptBasicTasks = LINKED_LIST_INIT;
+
+/**
+ * The basic task started on the current level of the stack of basic tasks, or
+ * the one preempted by this level if no basic task runs on it.
+ */
+static Lz_BasicTask *runningBasicTask = NULL;
+
+/**
+ * Indicates that the task running basic tasks will look for the next basic
+ * task to start by itself, so no basic task has to be preempted.
+ */
+static bool isNewBasicTasksLevel = true;
+
+/**
+ * The number of basic tasks preempted by another basic task.
+ */
+static uint8_t basicTasksNestingLevel = 0;
+
+/**
+ * Indicates that the task running basic tasks is on no queue, waiting for the
+ * activation of a basic task.
+ */
+static bool isBasicTasksExecutiveWaiting = false;
+
+/**
+ * The number of registered basic tasks.
+ */
+static uint8_t basicTasksCount = 0;
+
 /**
  * The scheduler idle task.
  *
@@ -119,6 +290,12 @@ PrepareTaskContext(Task * const task)
     = (TaskContextLayout *)(ALLOW_ARITHM(task->stackPointer)
                             - sizeof(TaskContextLayout) + 1);
 
+  /*
+   * The context may be built on a stack that has already been used, and the
+   * compiler expects r1 to be 0 when entering a function.
+   */
+  contextLayout->sreg = 0;
+  contextLayout->r1 = 0;
   contextLayout->pc = ReverseBytesOfFunctionPointer(task->entryPoint);
   contextLayout->terminationCallback =
     ReverseBytesOfFunctionPointer(Lz_Task_Terminate);
@@ -127,215 +304,1155 @@ PrepareTaskContext(Task * const task)
 }
 
 /**
- * Compare the "period" property of 2 tasks.
+ * Fill a newly allocated task stack with STACK_PAINT_PATTERN, so its high-water
+ * mark can be measured later.
  *
- * @param task1 A valid pointer to the first Task.
- * @param task2 A valid pointer to the second Task.
- *
- * @return
- *         - _true_ if @p task1 has a bigger period than @p task2.
- *         - _false_ if @p task1 has a lower period than @p task2.
+ * @param stack A pointer to the lowest address of the stack.
+ * @param size The size of the stack in bytes.
  */
-static bool
-PeriodComparer(const Task * const task1, const Task * const task2)
+static void
+PaintStack(void * const stack, const size_t size)
 {
-  return task1->period > task2->period;
+  uint8_t * const bytes = stack;
+  size_t i;
+
+  for (i = 0; i < size; ++i) {
+    bytes[i] = STACK_PAINT_PATTERN;
+  }
 }
 
 /**
- * Compare the "priority" property of 2 tasks.
+ * @cond false
  *
- * @param task1 A valid pointer to the first Task.
- * @param task2 A valid pointer to the second Task.
+ * CPU usage percentages are computed with 32-bit arithmetic.
+ */
+STATIC_ASSERT(!LZ_CONFIG_INSTRUMENT_CPU_USAGE ||
+              LZ_CONFIG_MODULE_ARITHMETIC_32_USED,
+              CPU_usage_instrumentation_needs_module_ARITHMETIC_32);
+/** @endcond */
+
+/**
+ * Account the CPU time consumed during the time slice that just ended.
  *
- * @return
- *         - _true_ if @p task1 has a bigger priority than @p task2.
- *         - _false_ if @p task1 has a lower priority than @p task2.
+ * If the current task went to sleep before the end of its time slice, it is
+ * only billed the time until it went to sleep. The rest of the time slice is
+ * billed to the idle task, as the CPU was sleeping.
+ *
+ * This is to be done at every clock tick.
  */
-static bool
-PriorityComparer(const Task * const task1, const Task * const task2)
+static void
+AccountCpuTime(void)
 {
-  return task1->priority > task2->priority;
+  const uint16_t period = Arch_GetSystemTimerPeriod();
+
+  if (!isSleepTimestampSet) {
+    cpuTimes[currentTask->id] += period;
+  } else {
+    cpuTimes[currentTask->id] += sleepTimestamp;
+    cpuTimes[idleTask->id] += period - sleepTimestamp;
+    isSleepTimestampSet = false;
+  }
 }
 
 /**
- * Insert a task in a list, keeping priorities ordered. The priority is
- * determined using the function pointer @p compareByProperty.
- *
- * If tasks with the same priority than the @p taskToInsert already exist in the
- * list, the @p taskToInsert will be inserted after existing tasks of the same
- * priority.
+ * Record the time at which the current task goes to sleep until the end of its
+ * time slice, if it is the first time in this time slice.
  *
- * @param list The list in which to insert the task.
- * @param taskToInsert The task to insert in the list.
- * @param compareByProperty A function pointer to the appropriate property
- *                          comparer.
+ * The timestamp is consumed by the clock tick, so it is read and stored with
+ * interrupts disabled. If the clock tick is already pending, the counter has
+ * wrapped and the task ran for its whole time slice, so nothing is recorded.
  */
 static void
-InsertTaskByPriority(Lz_LinkedList * const list,
-                     Task * const taskToInsert,
-                     bool (*compareByProperty)(const Task * const ,
-                                               const Task * const))
+RecordSleepTimestamp(void)
 {
-  Task *task;
-
-  /*
-   * This is commented on purpose.
-   * TODO: Find a neat way to perform the equivalent. This function is static
-   * so we master the parameters that are passed to that function.
-   * Static checking could do the job.
-   *
-   * if (NULL == list || NULL == taskToInsert || NULL == compareByProperty) {
-   *   return;
-   * }
-   */
+  InterruptsStatus interruptsStatus;
 
-  List_ForEach (list, Task, task, stateQueue) {
-    if (compareByProperty(task, taskToInsert)) {
-      List_InsertBefore(list,
-                        &task->stateQueue,
-                        &taskToInsert->stateQueue);
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
 
-      return;
-    }
+  if (!isSleepTimestampSet && !Arch_IsSystemTimerTickPending()) {
+    sleepTimestamp = Arch_GetSystemTimerCounter();
+    isSleepTimestampSet = true;
   }
 
-  List_Append(list, &taskToInsert->stateQueue);
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+/**
+ * Sample the program counter of the current task, interrupted by the clock
+ * tick.
+ *
+ * @param sp The stack pointer of the current task, pointing right below its
+ *           saved context.
+ */
+static void
+SampleProgramCounter(const void * const sp)
+{
+  const TaskContextLayout * const contextLayout
+    = (const TaskContextLayout *)(ALLOW_ARITHM(sp) + 1);
+  /* The program counter is saved with its most significant byte first */
+  const volatile uint8_t * const pc
+    = (const volatile uint8_t *)&contextLayout->pc;
+
+  Profiler_Sample(currentTask->id, ((uint16_t)pc[0] << 8) | pc[1]);
 }
 
 /**
  * @cond false
  *
- * This assertion is necessary because in the function PickTaskToRun() we
- * iterate over all the possible declared values of lz_scheduling_policy_t to
- * index the array readyTasks.
+ * The mean durations and the completion times of the jobs of cyclic tasks are
+ * computed with 32-bit arithmetic.
  */
-STATIC_ASSERT((LZ_SCHEDULING_POLICY_MAX + 1) == ELEMENTS_COUNT(readyTasks),
-              The_readyTasks_array_size_is_wrong);
+STATIC_ASSERT(!LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS ||
+              LZ_CONFIG_MODULE_ARITHMETIC_32_USED,
+              Cyclic_tasks_instrumentation_needs_module_ARITHMETIC_32);
 /** @endcond */
 
 /**
- * Pick the task ready to run with the highest priority.
- *
- * To perform that operation, we iterate ready tasks in each policy, from the
- * highest priority to the lowest until we find a task that is ready to run.
+ * Reset a duration accumulator.
  *
- * If no task is ready to run, we pick the idle task.
- *
- * @return A valid pointer to the next task to run.
+ * @param accumulator A pointer to the DurationAccumulator to reset.
  */
-static Task*
-PickTaskToRun(void)
+static void
+ResetDurationAccumulator(DurationAccumulator * const accumulator)
 {
-  lz_scheduling_policy_t policy;
-
-  for (policy = 0; policy < ELEMENTS_COUNT(readyTasks); ++policy) {
-    const Lz_LinkedListElement * const linkedListElement
-      = List_PickFirst(&readyTasks[policy]);
-
-    if (NULL != linkedListElement) {
-      return CONTAINER_OF(linkedListElement, stateQueue, Task);
-    }
-  }
-
-  return idleTask;
+  accumulator->min = 0;
+  accumulator->max = 0;
+  accumulator->sum = 0;
+  accumulator->count = 0;
 }
 
 /**
- * Update all registered cyclic RT tasks.
+ * Add a measured duration to a duration accumulator.
  *
- * This is to be done at every clock tick.
+ * @param accumulator A pointer to the DurationAccumulator.
+ * @param duration The measured duration.
  */
 static void
-UpdateCyclicRealTimeTasks(void)
+AccumulateDuration(DurationAccumulator * const accumulator,
+                   const uint32_t duration)
 {
-  Task *loopTask;
-  Lz_LinkedListElement *iterator;
-
-  /* Here we update the time until activation of all cyclic RT tasks */
-  List_ForEach(&readyTasks[CYCLIC_RT], Task, loopTask, stateQueue) {
-    --loopTask->timeUntilActivation;
-
-    if (0 == loopTask->timeUntilActivation) {
-      if (loopTask->timeUntilCompletion > 0) {
-        /* TODO: Missed deadline */
-      } else {
-        loopTask->timeUntilActivation = loopTask->period;
-      }
-    }
+  if (0 == accumulator->count || duration < accumulator->min) {
+    accumulator->min = duration;
   }
 
-  /* After updating, we check if a cyclic RT task is ready to run */
-  List_RemovableForEach(&waitingActivationTasks,
-                        Task,
-                        loopTask,
-                        stateQueue,
-                        iterator) {
-    --loopTask->timeUntilActivation;
-
-    if (0 == loopTask->timeUntilActivation) {
-      iterator = List_Remove(&waitingActivationTasks, &loopTask->stateQueue);
-      InsertTaskByPriority(&readyTasks[CYCLIC_RT], loopTask, PeriodComparer);
+  if (duration > accumulator->max) {
+    accumulator->max = duration;
+  }
 
-      loopTask->timeUntilActivation = loopTask->period;
-      loopTask->timeUntilCompletion = loopTask->completion;
-    }
+  if (accumulator->sum > UINT32_MAX - duration ||
+      UINT16_MAX == accumulator->count) {
+    accumulator->sum >>= 1;
+    accumulator->count >>= 1;
   }
+
+  accumulator->sum += duration;
+  ++accumulator->count;
 }
 
 /**
- * Update all tasks waiting for the expiration of a software timer.
+ * Compute the statistics of a duration accumulator.
  *
- * This is to be done at every clock tick.
+ * @param accumulator A pointer to the DurationAccumulator.
+ * @param statistics A pointer to the Lz_DurationStatistics to fill.
  */
 static void
-UpdateTasksWaitingSoftwareTimer(void)
+GetDurationStatistics(const DurationAccumulator * const accumulator,
+                      Lz_DurationStatistics * const statistics)
 {
-  Task *task;
-  Lz_LinkedListElement *iterator;
+  statistics->min = accumulator->min;
+  statistics->max = accumulator->max;
 
-  List_RemovableForEach(&waitingTimerTasks, Task, task, stateQueue, iterator) {
-    --task->timeUntilTimerExpiration;
-
-    if (0 == task->timeUntilTimerExpiration) {
-      iterator = List_Remove(&waitingTimerTasks, &task->stateQueue);
-      InsertTaskByPriority(&readyTasks[PRIORITY_RT], task, PriorityComparer);
-    }
+  if (0 == accumulator->count) {
+    statistics->mean = 0;
+  } else {
+    statistics->mean =
+      Arch_Divide_U32(accumulator->sum, accumulator->count).quotient;
   }
 }
 
 /**
- * Manage cyclic real-time tasks.
+ * Reset the statistics of the jobs of a cyclic task.
  *
- * @param message The message that the task passes to the scheduler.
+ * The state of the current job is kept.
+ *
+ * @param jobStatistics A pointer to the JobStatistics to reset.
  */
 static void
-ManageCyclicRealTimeTask(const lz_task_to_scheduler_message_t message)
+ResetJobStatistics(JobStatistics * const jobStatistics)
 {
-  --currentTask->timeUntilCompletion;
-
-  if (WAIT_ACTIVATION == message || 0 == currentTask->timeUntilCompletion) {
-    List_Append(&waitingActivationTasks, &currentTask->stateQueue);
-
-    return;
-  }
-
-  InsertTaskByPriority(&readyTasks[CYCLIC_RT], currentTask, PeriodComparer);
+  jobStatistics->maxExecutionTime = 0;
+  ResetDurationAccumulator(&jobStatistics->releaseJitter);
+  ResetDurationAccumulator(&jobStatistics->responseTime);
+  jobStatistics->jobsCount = 0;
+  jobStatistics->overrunsCount = 0;
+  jobStatistics->deadlineMissesCount = 0;
 }
 
 /**
- * Manage priority real-time tasks.
+ * Start the measure of a new job of a cyclic task, released at the current
+ * clock tick.
  *
- * @param message The message that the task passes to the scheduler.
+ * @param jobStatistics A pointer to the JobStatistics of the task.
  */
 static void
-ManagePriorityRealTimeTask(const lz_task_to_scheduler_message_t message)
+ReleaseJob(JobStatistics * const jobStatistics)
 {
-  bool setCurrentTaskReady = false;
-
-  if (WAIT_INTERRUPT == message) {
-    const uint8_t interruptCode =
-      *((uint8_t*)currentTask->taskToSchedulerMessageParameter);
+  jobStatistics->releaseTimestamp = timestampBase;
+  jobStatistics->executionTime = 0;
+  jobStatistics->isDispatched = false;
+  jobStatistics->isEnded = false;
+}
+
+/**
+ * Add the time elapsed since the task was switched in to the execution time of
+ * its current job.
+ *
+ * @param jobStatistics A pointer to the JobStatistics of the task.
+ * @param timestamp The current timestamp.
+ */
+static void
+AccountJobExecutionTime(JobStatistics * const jobStatistics,
+                        const uint32_t timestamp)
+{
+  if (jobStatistics->isDispatched && !jobStatistics->isEnded) {
+    jobStatistics->executionTime +=
+      timestamp - jobStatistics->dispatchTimestamp;
+    jobStatistics->dispatchTimestamp = timestamp;
+  }
+}
+
+/**
+ * End the measure of the current job of a cyclic task.
+ *
+ * @param jobStatistics A pointer to the JobStatistics of the task.
+ */
+static void
+EndJob(JobStatistics * const jobStatistics)
+{
+  if (jobStatistics->executionTime > jobStatistics->maxExecutionTime) {
+    jobStatistics->maxExecutionTime = jobStatistics->executionTime;
+  }
+
+  jobStatistics->isEnded = true;
+}
+
+/**
+ * Record that the current job of a cyclic task has reached its deadline before
+ * being complete.
+ *
+ * @param jobStatistics A pointer to the JobStatistics of the task.
+ */
+static void
+MissJobDeadline(JobStatistics * const jobStatistics)
+{
+  if (UINT16_MAX != jobStatistics->deadlineMissesCount) {
+    ++jobStatistics->deadlineMissesCount;
+  }
+}
+
+/**
+ * Record that the current task has been switched in, to measure the release
+ * jitter and the execution time of its current job.
+ *
+ * This is to be done each time a new current task is elected.
+ */
+static void
+RecordJobDispatch(void)
+{
+  JobStatistics * const jobStatistics = currentTask->jobStatistics;
+  uint32_t timestamp;
+
+  if (NULL == jobStatistics || jobStatistics->isEnded) {
+    return;
+  }
+
+  timestamp = Scheduler_GetTimestamp();
+  jobStatistics->dispatchTimestamp = timestamp;
+
+  if (!jobStatistics->isDispatched) {
+    jobStatistics->isDispatched = true;
+    AccumulateDuration(&jobStatistics->releaseJitter,
+                       timestamp - jobStatistics->releaseTimestamp);
+  }
+}
+
+/**
+ * Update the global counters of the kernel after a new current task has been
+ * elected.
+ *
+ * This is to be done at every clock tick.
+ *
+ * @param previousTask A pointer to the task that was running before the clock
+ *                     tick.
+ */
+static void
+UpdateKernelCounters(const Task * const previousTask)
+{
+  ++ticksCount;
+
+  if (currentTask != previousTask) {
+    ++contextSwitchesCount;
+  }
+
+  if (currentTask == idleTask) {
+    ++idleTicksCount;
+  }
+}
+
+/**
+ * Set the state of all the tasks of a scheduler queue in a table of task
+ * snapshots.
+ *
+ * @param list A pointer to the queue of tasks.
+ * @param state The state of the tasks of the queue.
+ * @param interruptCode The interrupt code to set in the snapshots.
+ * @param tasks A pointer to the table of Lz_TaskSnapshot, indexed by task ID.
+ * @param tasksCount The number of elements of @p tasks.
+ */
+static void
+SnapshotTasksState(const Lz_LinkedList * const list,
+                   const lz_task_state_t state,
+                   const uint8_t interruptCode,
+                   Lz_TaskSnapshot * const tasks,
+                   const uint8_t tasksCount)
+{
+  Task *task;
+
+  List_ForEach (list, Task, task, stateQueue) {
+    if (task->id < tasksCount) {
+      tasks[task->id].state = state;
+      tasks[task->id].interruptCode = interruptCode;
+    }
+  }
+}
+
+/**
+ * @cond false
+ *
+ * The utilization and the response times of cyclic tasks are computed with
+ * 32-bit arithmetic.
+ */
+STATIC_ASSERT(!LZ_CONFIG_SCHEDULABILITY_ANALYSIS ||
+              LZ_CONFIG_MODULE_ARITHMETIC_32_USED,
+              Schedulability_analysis_needs_module_ARITHMETIC_32);
+
+STATIC_ASSERT(!LZ_CONFIG_CHECK_SCHEDULABILITY_AT_RUN ||
+              LZ_CONFIG_SCHEDULABILITY_ANALYSIS,
+              Schedulability_check_needs_schedulability_analysis);
+/** @endcond */
+
+/**
+ * The Liu-Layland bounds n * (2^(1/n) - 1) in permille, rounded down, indexed
+ * by the number of tasks minus 1.
+ */
+static PROGMEM const uint16_t LiuLaylandBounds[] = {
+  1000, 828, 779, 756, 743, 734, 728, 724, 720, 717
+};
+
+/**
+ * The limit of the Liu-Layland bound when the number of tasks grows, i.e.
+ * ln(2) in permille, rounded down.
+ */
+#define LIU_LAYLAND_BOUND_LIMIT ((uint16_t)693)
+
+/**
+ * Divide two numbers, rounding the quotient up.
+ *
+ * @param numerator The numerator of the division.
+ * @param denominator The denominator of the division, greater than 0.
+ *
+ * @return The quotient of the division, rounded up.
+ */
+static uint32_t
+DivideRoundUp(const uint32_t numerator, const uint32_t denominator)
+{
+  const U32DivisionResult result = Arch_Divide_U32(numerator, denominator);
+
+  return result.quotient + (0 == result.remainder ? 0 : 1);
+}
+
+/**
+ * Compute the worst-case response time of a cyclic real-time task.
+ *
+ * Cyclic real-time tasks preempt each other only at clock ticks, and each job
+ * is charged whole time slices, so the response time analysis is exact in time
+ * slices. The worst case is when all tasks are released at the same time.
+ * Tasks of same deadline are considered to interfere with each other.
+ *
+ * @param task A pointer to the cyclic real-time Task.
+ *
+ * @return The worst-case response time of the task, or the first value found
+ *         above its deadline if the task is not schedulable.
+ */
+static uint32_t
+ComputeResponseTime(const Task * const task)
+{
+  Task *loopTask;
+  uint32_t previousResponseTime;
+  uint32_t responseTime = task->completion;
+
+  do {
+    previousResponseTime = responseTime;
+    responseTime = task->completion;
+
+    List_ForEach (&registeredTasks, Task, loopTask, registeredTasksQueue) {
+      if (loopTask != task &&
+          CYCLIC_RT == loopTask->schedulingPolicy &&
+          loopTask->deadline <= task->deadline) {
+        responseTime +=
+          Arch_Multiply_U32(DivideRoundUp(previousResponseTime,
+                                          loopTask->period),
+                            loopTask->completion);
+      }
+    }
+  } while (responseTime != previousResponseTime &&
+           responseTime <= task->deadline);
+
+  return responseTime;
+}
+
+/**
+ * Compare the "period" property of 2 tasks.
+ *
+ * @param task1 A valid pointer to the first Task.
+ * @param task2 A valid pointer to the second Task.
+ *
+ * @return
+ *         - _true_ if @p task1 has a bigger period than @p task2.
+ *         - _false_ if @p task1 has a lower period than @p task2.
+ */
+static bool
+PeriodComparer(const Task * const task1, const Task * const task2)
+{
+  return task1->period > task2->period;
+}
+
+/**
+ * Compare the "deadline" property of 2 tasks, then their "period" property if
+ * they have the same deadline.
+ *
+ * @param task1 A valid pointer to the first Task.
+ * @param task2 A valid pointer to the second Task.
+ *
+ * @return
+ *         - _true_ if @p task1 has a bigger deadline than @p task2.
+ *         - _false_ if @p task1 has a lower deadline than @p task2.
+ */
+static bool
+DeadlineComparer(const Task * const task1, const Task * const task2)
+{
+  if (task1->deadline == task2->deadline) {
+    return PeriodComparer(task1, task2);
+  }
+
+  return task1->deadline > task2->deadline;
+}
+
+/**
+ * Compare the "priority" property of 2 tasks.
+ *
+ * @param task1 A valid pointer to the first Task.
+ * @param task2 A valid pointer to the second Task.
+ *
+ * @return
+ *         - _true_ if @p task1 has a bigger priority than @p task2.
+ *         - _false_ if @p task1 has a lower priority than @p task2.
+ */
+static bool
+PriorityComparer(const Task * const task1, const Task * const task2)
+{
+  return task1->priority > task2->priority;
+}
+
+/**
+ * Compare the "priority" property of 2 tasks, so that a task is inserted ahead
+ * of the tasks of the same priority.
+ *
+ * @param task1 A valid pointer to the first Task.
+ * @param task2 A valid pointer to the second Task.
+ *
+ * @return
+ *         - _true_ if @p task1 has a bigger or equal priority number than
+ *           @p task2.
+ *         - _false_ if @p task1 has a lower priority number than @p task2.
+ */
+static bool
+PriorityOrEqualComparer(const Task * const task1, const Task * const task2)
+{
+  return task1->priority >= task2->priority;
+}
+
+/**
+ * Never order a task before another one, so that tasks are queued in their
+ * order of arrival.
+ *
+ * @param task1 A valid pointer to the first Task.
+ * @param task2 A valid pointer to the second Task.
+ *
+ * @return _false_.
+ */
+static bool
+ArrivalComparer(const Task * const task1, const Task * const task2)
+{
+  UNUSED(task1);
+  UNUSED(task2);
+
+  return false;
+}
+
+/**
+ * Insert a task in a list, keeping priorities ordered. The priority is
+ * determined using the function pointer @p compareByProperty.
+ *
+ * If tasks with the same priority than the @p taskToInsert already exist in the
+ * list, the @p taskToInsert will be inserted after existing tasks of the same
+ * priority.
+ *
+ * @param list The list in which to insert the task.
+ * @param taskToInsert The task to insert in the list.
+ * @param compareByProperty A function pointer to the appropriate property
+ *                          comparer.
+ */
+static void
+InsertTaskByPriority(Lz_LinkedList * const list,
+                     Task * const taskToInsert,
+                     bool (*compareByProperty)(const Task * const ,
+                                               const Task * const))
+{
+  Task *task;
+
+  /*
+   * This is commented on purpose.
+   * TODO: Find a neat way to perform the equivalent. This function is static
+   * so we master the parameters that are passed to that function.
+   * Static checking could do the job.
+   *
+   * if (NULL == list || NULL == taskToInsert || NULL == compareByProperty) {
+   *   return;
+   * }
+   */
+
+  List_ForEach (list, Task, task, stateQueue) {
+    if (compareByProperty(task, taskToInsert)) {
+      List_InsertBefore(list,
+                        &task->stateQueue,
+                        &taskToInsert->stateQueue);
+
+      return;
+    }
+  }
+
+  List_Append(list, &taskToInsert->stateQueue);
+}
+
+/**
+ * Check if a priority real-time task has consumed its CPU budget.
+ *
+ * @param task A pointer to the priority real-time Task.
+ *
+ * @return
+ *         - _true_ if the task has a budget, and has consumed it.
+ *         - _false_ otherwise.
+ */
+static bool
+IsBudgetConsumed(const Task * const task)
+{
+  return LZ_CONFIG_TASK_BUDGETS &&
+    task->completion > 0 &&
+    0 == task->timeUntilCompletion;
+}
+
+/**
+ * Make a priority real-time task or a cooperative task ready to run, or
+ * throttle it if it has consumed its CPU budget.
+ *
+ * @param task A pointer to the priority real-time or cooperative Task, that
+ *             must be on no queue.
+ */
+static void
+SetTaskReady(Task * const task)
+{
+  if (COOPERATIVE == task->schedulingPolicy) {
+    List_Append(&readyTasks[COOPERATIVE], &task->stateQueue);
+
+    return;
+  }
+
+  if (IsBudgetConsumed(task)) {
+    List_Append(&throttledTasks, &task->stateQueue);
+
+    return;
+  }
+
+  InsertTaskByPriority(&readyTasks[PRIORITY_RT], task, PriorityComparer);
+}
+
+/**
+ * Delay the release of the first job of a cyclic real-time task.
+ *
+ * @param task A pointer to the cyclic real-time Task, that must be on no
+ *             queue.
+ * @param offset The release offset of the task, greater than 0.
+ */
+static void
+DelayFirstRelease(Task * const task, const lz_u_resolution_unit_t offset)
+{
+  task->offset = offset;
+  task->timeUntilActivation = offset;
+  task->timeUntilCompletion = 0;
+
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+    /* No job is measured until the first release */
+    task->jobStatistics->isEnded = true;
+  }
+
+  List_Append(&waitingActivationTasks, &task->stateQueue);
+}
+
+/**
+ * @cond false
+ *
+ * The release offsets are chosen with 16-bit divisions.
+ */
+STATIC_ASSERT(!LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS ||
+              LZ_CONFIG_MODULE_DIVISION_USED,
+              Automatic_release_offsets_needs_module_DIVISION);
+/** @endcond */
+
+/**
+ * Get the greatest common divisor of 2 numbers.
+ *
+ * @param a The first number, greater than 0.
+ * @param b The second number, greater than 0.
+ *
+ * @return The greatest common divisor of @p a and @p b.
+ */
+static uint16_t
+GreatestCommonDivisor(uint16_t a, uint16_t b)
+{
+  uint16_t remainder;
+
+  while (0 != b) {
+    remainder = Arch_Divide_U16(a, b).remainder;
+    a = b;
+    b = remainder;
+  }
+
+  return a;
+}
+
+/**
+ * Choose the release offset of a cyclic real-time task, so it is released at
+ * the same clock ticks as the fewest other cyclic tasks.
+ *
+ * 2 tasks of periods T1 and T2 and offsets O1 and O2 are released at the same
+ * clock ticks if and only if O1 and O2 are congruent modulo gcd(T1, T2). Only
+ * the tasks whose offset is already known are taken into account. Among the
+ * offsets giving the fewest collisions, the lowest one is chosen.
+ *
+ * The cost is proportional to the period of the task times the number of
+ * cyclic tasks, so it is only done once, when the scheduler starts.
+ *
+ * @param task A pointer to the cyclic real-time Task.
+ *
+ * @return The release offset of the task.
+ */
+static lz_u_resolution_unit_t
+ChooseReleaseOffset(const Task * const task)
+{
+  Task *loopTask;
+  lz_u_resolution_unit_t offset;
+  lz_u_resolution_unit_t bestOffset = 0;
+  uint16_t distance;
+  uint8_t collisions;
+  uint8_t fewestCollisions = UINT8_MAX;
+
+  for (offset = 0; offset < task->period; ++offset) {
+    collisions = 0;
+
+    List_ForEach (&registeredTasks, Task, loopTask, registeredTasksQueue) {
+      if (CYCLIC_RT != loopTask->schedulingPolicy ||
+          LZ_RELEASE_OFFSET_AUTOMATIC == loopTask->offset) {
+        continue;
+      }
+
+      distance = offset > loopTask->offset ?
+        offset - loopTask->offset : loopTask->offset - offset;
+
+      if (0 == Arch_Divide_U16(distance,
+                               GreatestCommonDivisor(task->period,
+                                                     loopTask->period))
+          .remainder) {
+        ++collisions;
+      }
+    }
+
+    if (collisions < fewestCollisions) {
+      fewestCollisions = collisions;
+      bestOffset = offset;
+
+      if (0 == collisions) {
+        break;
+      }
+    }
+  }
+
+  return bestOffset;
+}
+
+/**
+ * Choose the release offsets of all cyclic real-time tasks registered with
+ * LZ_RELEASE_OFFSET_AUTOMATIC.
+ *
+ * Tasks are taken in order of deadline, so the most urgent tasks get the
+ * lowest offsets.
+ *
+ * This is to be done once, before the scheduler starts.
+ */
+static void
+AssignReleaseOffsets(void)
+{
+  Task *task;
+  Lz_LinkedListElement *iterator;
+  lz_u_resolution_unit_t offset;
+
+  List_RemovableForEach(&readyTasks[CYCLIC_RT],
+                        Task,
+                        task,
+                        stateQueue,
+                        iterator) {
+    if (LZ_RELEASE_OFFSET_AUTOMATIC != task->offset) {
+      continue;
+    }
+
+    offset = ChooseReleaseOffset(task);
+
+    if (0 == offset) {
+      task->offset = 0;
+    } else {
+      iterator = List_Remove(&readyTasks[CYCLIC_RT], &task->stateQueue);
+      DelayFirstRelease(task, offset);
+    }
+  }
+}
+
+/**
+ * @cond false
+ *
+ * This assertion is necessary because in the function PickTaskToRun() we
+ * iterate over all the possible declared values of lz_scheduling_policy_t to
+ * index the array readyTasks.
+ */
+STATIC_ASSERT((LZ_SCHEDULING_POLICY_MAX + 1) == ELEMENTS_COUNT(readyTasks),
+              The_readyTasks_array_size_is_wrong);
+/** @endcond */
+
+/**
+ * Pick the task ready to run with the highest priority.
+ *
+ * To perform that operation, we iterate ready tasks in each policy, from the
+ * highest priority to the lowest until we find a task that is ready to run.
+ *
+ * If no task is ready to run, we pick the idle task.
+ *
+ * @return A valid pointer to the next task to run.
+ */
+static Task*
+PickTaskToRun(void)
+{
+  lz_scheduling_policy_t policy;
+
+  for (policy = 0; policy < ELEMENTS_COUNT(readyTasks); ++policy) {
+    const Lz_LinkedListElement * const linkedListElement
+      = List_PickFirst(&readyTasks[policy]);
+
+    if (NULL != linkedListElement) {
+      return CONTAINER_OF(linkedListElement, stateQueue, Task);
+    }
+  }
+
+  return idleTask;
+}
+
+/**
+ * Update all registered cyclic RT tasks.
+ *
+ * This is to be done at every clock tick.
+ */
+static void
+UpdateCyclicRealTimeTasks(void)
+{
+  Task *loopTask;
+  Lz_LinkedListElement *iterator;
+
+  /* Here we update the time until activation of all cyclic RT tasks */
+  List_ForEach(&readyTasks[CYCLIC_RT], Task, loopTask, stateQueue) {
+    --loopTask->timeUntilActivation;
+
+    /* The deadline is reached while the job is not complete */
+    if (loopTask->timeUntilCompletion > 0 &&
+        loopTask->period - loopTask->deadline ==
+        loopTask->timeUntilActivation) {
+      /* TODO: Handle missed deadlines */
+      if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+        MissJobDeadline(loopTask->jobStatistics);
+      }
+    }
+
+    if (0 == loopTask->timeUntilActivation &&
+        0 == loopTask->timeUntilCompletion) {
+      loopTask->timeUntilActivation = loopTask->period;
+    }
+  }
+
+  /* After updating, we check if a cyclic RT task is ready to run */
+  List_RemovableForEach(&waitingActivationTasks,
+                        Task,
+                        loopTask,
+                        stateQueue,
+                        iterator) {
+    --loopTask->timeUntilActivation;
+
+    if (0 == loopTask->timeUntilActivation) {
+      iterator = List_Remove(&waitingActivationTasks, &loopTask->stateQueue);
+      InsertTaskByPriority(&readyTasks[CYCLIC_RT], loopTask, DeadlineComparer);
+      TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_TASK_ACTIVATION,
+                                      loopTask->id);
+
+      if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+        ReleaseJob(loopTask->jobStatistics);
+      }
+
+      loopTask->timeUntilActivation = loopTask->period;
+      loopTask->timeUntilCompletion = loopTask->completion;
+    }
+  }
+}
+
+/**
+ * Update all tasks waiting for the expiration of a software timer.
+ *
+ * This is to be done at every clock tick.
+ */
+static void
+UpdateTasksWaitingSoftwareTimer(void)
+{
+  Task *task;
+  Lz_LinkedListElement *iterator;
+
+  List_RemovableForEach(&waitingTimerTasks, Task, task, stateQueue, iterator) {
+    --task->timeUntilTimerExpiration;
+
+    if (0 == task->timeUntilTimerExpiration) {
+      iterator = List_Remove(&waitingTimerTasks, &task->stateQueue);
+      SetTaskReady(task);
+      TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_TIMER_EXPIRY, task->id);
+    }
+  }
+}
+
+/**
+ * Manage cyclic real-time tasks.
+ *
+ * @param message The message that the task passes to the scheduler.
+ */
+static void
+ManageCyclicRealTimeTask(const lz_task_to_scheduler_message_t message)
+{
+  --currentTask->timeUntilCompletion;
+
+  if (WAIT_ACTIVATION == message || 0 == currentTask->timeUntilCompletion) {
+    if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS && WAIT_ACTIVATION != message &&
+        !currentTask->jobStatistics->isEnded) {
+      JobStatistics * const jobStatistics = currentTask->jobStatistics;
+
+      /* The job has consumed its whole completion time */
+      if (UINT16_MAX != jobStatistics->overrunsCount) {
+        ++jobStatistics->overrunsCount;
+      }
+
+      EndJob(jobStatistics);
+    }
+
+    List_Append(&waitingActivationTasks, &currentTask->stateQueue);
+
+    return;
+  }
+
+  InsertTaskByPriority(&readyTasks[CYCLIC_RT], currentTask, DeadlineComparer);
+}
+
+/**
+ * Get the first activated basic task, i.e. the one of the highest priority.
+ *
+ * @return
+ *         - A pointer to the first activated Lz_BasicTask.
+ *         - _NULL_ if no basic task is activated.
+ */
+static Lz_BasicTask *
+GetFirstPendingBasicTask(void)
+{
+  const Lz_LinkedListElement * const linkedListElement
+    = List_PointFirst(&pendingBasicTasks);
+
+  if (NULL == linkedListElement) {
+    return NULL;
+  }
+
+  return CONTAINER_OF(linkedListElement, pendingQueue, Lz_BasicTask);
+}
+
+/**
+ * Check if the first activated basic task must start on the current level of
+ * the stack of basic tasks, i.e. if its priority is higher than the one of the
+ * running basic task.
+ *
+ * @return
+ *         - _true_ if a basic task must start.
+ *         - _false_ otherwise.
+ */
+static bool
+IsBasicTaskToStart(void)
+{
+  const Lz_BasicTask * const basicTask = GetFirstPendingBasicTask();
+
+  return NULL != basicTask &&
+    (NULL == runningBasicTask ||
+     basicTask->priority < runningBasicTask->priority);
+}
+
+/**
+ * Activate a basic task.
+ *
+ * The basic task is inserted behind the activated basic tasks of the same
+ * priority.
+ *
+ * This function must be called with interrupts disabled.
+ *
+ * @param basicTask A pointer to the registered Lz_BasicTask to activate.
+ *
+ * @return
+ *         - _true_ if the basic task has been activated.
+ *         - _false_ if the basic task was already activated.
+ */
+static bool
+ActivateBasicTask(Lz_BasicTask * const basicTask)
+{
+  Lz_BasicTask *pendingBasicTask;
+
+  if (basicTask->isPending) {
+    return false;
+  }
+
+  basicTask->isPending = true;
+
+  List_ForEach (&pendingBasicTasks,
+                Lz_BasicTask,
+                pendingBasicTask,
+                pendingQueue) {
+    if (pendingBasicTask->priority > basicTask->priority) {
+      List_InsertBefore(&pendingBasicTasks,
+                        &pendingBasicTask->pendingQueue,
+                        &basicTask->pendingQueue);
+
+      return true;
+    }
+  }
+
+  List_Append(&pendingBasicTasks, &basicTask->pendingQueue);
+
+  return true;
+}
+
+/**
+ * Give the task running basic tasks the priority of the highest basic task
+ * activated or running, and make it ready if it was waiting for an activation.
+ *
+ * The task running basic tasks must not be the current task, unless it has
+ * already been managed by the scheduler.
+ */
+static void
+UpdateBasicTasksExecutive(void)
+{
+  const Lz_BasicTask * const basicTask = GetFirstPendingBasicTask();
+  lz_task_priority_t priority = basicTasksExecutive->priority;
+
+  if (NULL != basicTask) {
+    priority = basicTask->priority;
+  }
+
+  if (NULL != runningBasicTask &&
+      (NULL == basicTask || runningBasicTask->priority < priority)) {
+    priority = runningBasicTask->priority;
+  }
+
+  if (isBasicTasksExecutiveWaiting) {
+    if (NULL == basicTask) {
+      return;
+    }
+
+    isBasicTasksExecutiveWaiting = false;
+  } else if (priority != basicTasksExecutive->priority) {
+    List_Remove(&readyTasks[PRIORITY_RT], &basicTasksExecutive->stateQueue);
+  } else {
+    return;
+  }
+
+  basicTasksExecutive->priority = priority;
+  SetTaskReady(basicTasksExecutive);
+}
+
+/**
+ * Activate the periodic basic tasks whose period ends, and update the task
+ * running basic tasks.
+ *
+ * This is to be done at every clock tick.
+ */
+static void
+UpdateBasicTasks(void)
+{
+  Lz_BasicTask *basicTask;
+
+  List_ForEach (&periodicBasicTasks,
+                Lz_BasicTask,
+                basicTask,
+                activationQueue) {
+    --basicTask->timeUntilActivation;
+
+    if (0 == basicTask->timeUntilActivation) {
+      basicTask->timeUntilActivation = basicTask->period;
+      ActivateBasicTask(basicTask);
+    }
+  }
+
+  UpdateBasicTasksExecutive();
+}
+
+/**
+ * End the current level of the stack of basic tasks, once the task running
+ * basic tasks has no more basic task to start on it.
+ *
+ * @return
+ *         - _true_ if the task running basic tasks stays ready, to start an
+ *           activated basic task or to go back to the preempted one.
+ *         - _false_ if it waits for the activation of a basic task.
+ */
+static bool
+EndBasicTasksLevel(void)
+{
+  /* A basic task has been activated since the task looked for one */
+  if (IsBasicTaskToStart()) {
+    return true;
+  }
+
+  if (basicTasksNestingLevel > 0) {
+    /* The task resumes the preempted basic task, on the level below */
+    --basicTasksNestingLevel;
+    basicTasksExecutive->stackPointer = runningBasicTask->stackPointer;
+    isNewBasicTasksLevel = false;
+
+    return true;
+  }
+
+  isBasicTasksExecutiveWaiting = true;
+
+  return false;
+}
+
+/**
+ * Make the running basic task preempted by the first activated basic task, if
+ * its priority is higher.
+ *
+ * A new level is pushed on the stack of basic tasks: the context of the task
+ * running basic tasks is saved in the preempted basic task, and a new context
+ * is built below it, that starts BasicTasksDispatcher() again.
+ *
+ * This is to be done when the task running basic tasks has been elected.
+ */
+static void
+PreemptBasicTask(void)
+{
+  const uint8_t * const stackEnd
+    = ALLOW_ARITHM(basicTasksExecutive->stackOrigin)
+    - basicTasksExecutive->stackSize + 1;
+
+  if (isNewBasicTasksLevel || !IsBasicTaskToStart()) {
+    return;
+  }
+
+  /* The stack must hold the context of the new level */
+  if (ALLOW_ARITHM(basicTasksExecutive->stackPointer) + 1 <
+      stackEnd + sizeof(TaskContextLayout)) {
+    Kernel_Panic();
+  }
+
+  runningBasicTask->stackPointer = basicTasksExecutive->stackPointer;
+  PrepareTaskContext(basicTasksExecutive);
+  ++basicTasksNestingLevel;
+  isNewBasicTasksLevel = true;
+}
+
+/**
+ * Check if a message of the task running basic tasks is allowed. Basic tasks
+ * must never block, nor terminate.
+ *
+ * @param message The message that the task passes to the scheduler.
+ *
+ * @return
+ *         - _true_ if the message is allowed.
+ *         - _false_ otherwise.
+ */
+static bool
+IsBasicTasksMessageAllowed(const lz_task_to_scheduler_message_t message)
+{
+  return NO_MESSAGE == message ||
+    END_BASIC_TASKS == message ||
+    YIELD_TASK == message;
+}
+
+/**
+ * The entry point of the task running basic tasks.
+ *
+ * Each level of the stack of basic tasks runs this function from its start: it
+ * runs to completion the activated basic tasks of higher priority than the
+ * preempted one, then tells the scheduler that the level ends.
+ */
+static void
+BasicTasksDispatcher(void)
+{
+  Lz_BasicTask *basicTask;
+
+  for (;;) {
+    basicTask = Scheduler_StartBasicTask();
+
+    while (NULL != basicTask) {
+      basicTask->entryPoint();
+      Scheduler_EndBasicTask();
+      basicTask = Scheduler_StartBasicTask();
+    }
+
+    currentTask->taskToSchedulerMessage = END_BASIC_TASKS;
+
+    Scheduler_SleepUntilEndOfTimeSlice();
+  }
+}
+
+/**
+ * Put the current task on the queue of the event it waits for, if any.
+ *
+ * @param message The message that the task passes to the scheduler.
+ *
+ * @return
+ *         - _true_ if the task doesn't wait for an event, and stays ready.
+ *         - _false_ if the task has been put on a queue, or waits for the
+ *           activation of a basic task.
+ */
+static bool
+WaitEvent(const lz_task_to_scheduler_message_t message)
+{
+  if (WAIT_INTERRUPT == message) {
+    const uint8_t interruptCode =
+      *((uint8_t*)currentTask->taskToSchedulerMessageParameter);
 
     /*
      * If the requested interrupt code is not an acceptable value, we abort the
@@ -345,31 +1462,199 @@ ManagePriorityRealTimeTask(const lz_task_to_scheduler_message_t message)
         (interruptCode > INT_LAST_ENTRY)) {
       List_Append(&abortedTasks, &currentTask->stateQueue);
 
-      return;
+      return false;
+    }
+
+    List_Prepend(&waitingInterruptsTasks[interruptCode],
+                 &currentTask->stateQueue);
+  } else if (WAIT_SOFTWARE_TIMER == message) {
+    currentTask->timeUntilTimerExpiration =
+      *(lz_u_resolution_unit_t*)currentTask->taskToSchedulerMessageParameter;
+    if (0 == currentTask->timeUntilTimerExpiration) {
+      return true;
+    }
+
+    List_Append(&waitingTimerTasks, &currentTask->stateQueue);
+  } else if (LZ_CONFIG_MODULE_MUTEX_USED && (WAIT_MUTEX == message)) {
+    Lz_Mutex * const mutex = currentTask->taskToSchedulerMessageParameter;
+    List_Prepend(&mutex->waitingTasks, &currentTask->stateQueue);
+    TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_MUTEX_BLOCK,
+                                    currentTask->id);
+  } else if (LZ_CONFIG_BASIC_TASKS && (END_BASIC_TASKS == message)) {
+    return EndBasicTasksLevel();
+  } else {
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Manage priority real-time tasks.
+ *
+ * @param message The message that the task passes to the scheduler.
+ */
+static void
+ManagePriorityRealTimeTask(const lz_task_to_scheduler_message_t message)
+{
+  bool setCurrentTaskReady;
+  bool isQuantumLeft = false;
+
+  /* Only tasks that have a budget have time until completion */
+  if (LZ_CONFIG_TASK_BUDGETS && currentTask->timeUntilCompletion > 0) {
+    --currentTask->timeUntilCompletion;
+  }
+
+  /*
+   * The quantum goes on while the task computes. It starts again once it
+   * expires, or when the task gives up the processor.
+   */
+  if (NO_MESSAGE == message) {
+    --currentTask->timeUntilQuantumExpiration;
+    isQuantumLeft = currentTask->timeUntilQuantumExpiration > 0 &&
+      !IsBudgetConsumed(currentTask);
+  }
+
+  if (!isQuantumLeft) {
+    currentTask->timeUntilQuantumExpiration = currentTask->quantum;
+  }
+
+  setCurrentTaskReady = WaitEvent(message);
+
+  if (isQuantumLeft) {
+    /* The task stays ahead of the tasks of the same priority */
+    InsertTaskByPriority(&readyTasks[PRIORITY_RT],
+                         currentTask,
+                         PriorityOrEqualComparer);
+  } else if (setCurrentTaskReady) {
+    SetTaskReady(currentTask);
+  }
+}
+
+/**
+ * Manage cooperative tasks.
+ *
+ * A cooperative task that computes until the end of its time slice stays at
+ * the head of the ready cooperative tasks, so it runs again as soon as no
+ * real-time task is ready.
+ *
+ * @param message The message that the task passes to the scheduler.
+ */
+static void
+ManageCooperativeTask(const lz_task_to_scheduler_message_t message)
+{
+  if (!WaitEvent(message)) {
+    return;
+  }
+
+  if (NO_MESSAGE == message) {
+    List_Prepend(&readyTasks[COOPERATIVE], &currentTask->stateQueue);
+  } else {
+    List_Append(&readyTasks[COOPERATIVE], &currentTask->stateQueue);
+  }
+}
+
+/**
+ * Replenish the CPU budgets of priority real-time tasks at the end of their
+ * period, and make ready the throttled tasks whose budget has been replenished.
+ *
+ * This is to be done at every clock tick.
+ */
+static void
+UpdateTaskBudgets(void)
+{
+  Task *task;
+  Lz_LinkedListElement *iterator;
+  uint8_t i;
+
+  for (i = 0; i < budgetedTasksCount; ++i) {
+    task = budgetedTasks[i];
+
+    --task->timeUntilActivation;
+
+    if (0 == task->timeUntilActivation) {
+      task->timeUntilActivation = task->period;
+      task->timeUntilCompletion = task->completion;
     }
+  }
 
-    List_Prepend(&waitingInterruptsTasks[interruptCode],
-                 &currentTask->stateQueue);
-  } else if (WAIT_SOFTWARE_TIMER == message) {
-    currentTask->timeUntilTimerExpiration =
-      *(lz_u_resolution_unit_t*)currentTask->taskToSchedulerMessageParameter;
-    if (0 == currentTask->timeUntilTimerExpiration) {
-      setCurrentTaskReady = true;
-    } else {
-      List_Append(&waitingTimerTasks, &currentTask->stateQueue);
+  List_RemovableForEach(&throttledTasks, Task, task, stateQueue, iterator) {
+    if (task->timeUntilCompletion > 0) {
+      iterator = List_Remove(&throttledTasks, &task->stateQueue);
+      InsertTaskByPriority(&readyTasks[PRIORITY_RT], task, PriorityComparer);
     }
-  } else if (LZ_CONFIG_MODULE_MUTEX_USED && (WAIT_MUTEX == message)) {
-    Lz_Mutex * const mutex = currentTask->taskToSchedulerMessageParameter;
-    List_Prepend(&mutex->waitingTasks, &currentTask->stateQueue);
-  } else {
-    setCurrentTaskReady = true;
   }
+}
 
-  if (setCurrentTaskReady) {
-    InsertTaskByPriority(&readyTasks[PRIORITY_RT],
-                         currentTask,
-                         PriorityComparer);
+/**
+ * Gather the priority real-time tasks that have a CPU budget, so their budgets
+ * are replenished without walking all the registered tasks.
+ *
+ * This is to be done once, before the scheduler starts.
+ *
+ * @return
+ *         - _true_ if the tasks have been gathered.
+ *         - _false_ if there is not enough memory.
+ */
+static bool
+PrepareTaskBudgets(void)
+{
+  Task *task;
+  uint8_t count = 0;
+
+  if (0 == budgetedTasksCount) {
+    return true;
   }
+
+  budgetedTasks = KIncrementalMalloc(budgetedTasksCount * sizeof(Task *));
+  if (NULL == budgetedTasks) {
+    return false;
+  }
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    if (PRIORITY_RT == task->schedulingPolicy && task->completion > 0) {
+      budgetedTasks[count++] = task;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Allocate the per-task counters of the enabled instrumentation, indexed by
+ * task ID, so tasks don't carry them when it is disabled.
+ *
+ * This is to be done once, after the registration of the idle task.
+ *
+ * @return
+ *         - _true_ if the counters have been allocated.
+ *         - _false_ if there is not enough memory.
+ */
+static bool
+AllocateTaskCounters(void)
+{
+  uint8_t i;
+
+  if (LZ_CONFIG_INSTRUMENT_CPU_USAGE) {
+    cpuTimes = KIncrementalMalloc(registeredTasksCount * sizeof(uint32_t));
+    if (NULL == cpuTimes) {
+      return false;
+    }
+
+    for (i = 0; i < registeredTasksCount; ++i) {
+      cpuTimes[i] = 0;
+    }
+  }
+
+  if (LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED) {
+    interruptTimestamps
+      = KIncrementalMalloc(registeredTasksCount * sizeof(uint32_t));
+    if (NULL == interruptTimestamps) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 /**
@@ -403,6 +1688,12 @@ Schedule(void)
     const lz_task_to_scheduler_message_t message
       = currentTask->taskToSchedulerMessage;
 
+    /* A basic task has blocked, or the stack of basic tasks has overflowed */
+    if (LZ_CONFIG_BASIC_TASKS && currentTask == basicTasksExecutive &&
+        !IsBasicTasksMessageAllowed(message)) {
+      Kernel_Panic();
+    }
+
     if (ABORT_TASK == message) {
       List_Append(&abortedTasks, &currentTask->stateQueue);
     } else if (TERMINATE_TASK == message) {
@@ -414,7 +1705,8 @@ Schedule(void)
         (const lz_task_to_scheduler_message_t) =
         {
           ManageCyclicRealTimeTask,
-          ManagePriorityRealTimeTask
+          ManagePriorityRealTimeTask,
+          ManageCooperativeTask
         };
 
       jumpToManager[currentTask->schedulingPolicy](message);
@@ -423,9 +1715,169 @@ Schedule(void)
 
   UpdateCyclicRealTimeTasks();
 
+  if (LZ_CONFIG_TASK_BUDGETS) {
+    UpdateTaskBudgets();
+  }
+
+  if (LZ_CONFIG_BASIC_TASKS && NULL != basicTasksExecutive) {
+    UpdateBasicTasks();
+  }
+
   currentTask->taskToSchedulerMessage = NO_MESSAGE;
 
   currentTask = PickTaskToRun();
+
+  if (LZ_CONFIG_BASIC_TASKS && currentTask == basicTasksExecutive) {
+    PreemptBasicTask();
+  }
+}
+
+/**
+ * @cond false
+ *
+ * The time-triggered scheduler doesn't follow the releases of jobs, and the
+ * tasks streaming the trace and running basic tasks have no slot in the
+ * schedule table.
+ */
+STATIC_ASSERT(!LZ_CONFIG_TIME_TRIGGERED_SCHEDULING ||
+              !LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS,
+              Time_triggered_scheduling_cant_instrument_cyclic_tasks);
+
+STATIC_ASSERT(!LZ_CONFIG_TIME_TRIGGERED_SCHEDULING ||
+              !LZ_CONFIG_MODULE_TRACE_USED,
+              Time_triggered_scheduling_cant_use_module_TRACE);
+
+STATIC_ASSERT(!LZ_CONFIG_TIME_TRIGGERED_SCHEDULING || !LZ_CONFIG_BASIC_TASKS,
+              Time_triggered_scheduling_cant_use_basic_tasks);
+/** @endcond */
+
+/**
+ * Get the task to run during a slot of the schedule table.
+ *
+ * @param slot The index of the slot in the schedule table.
+ *
+ * @return A pointer to the Task to run.
+ */
+static Task *
+GetScheduleSlotTask(const uint16_t slot)
+{
+  const uint8_t entry = Arch_LoadU8FromProgmem(&scheduleTable[slot]);
+  const uint8_t taskId = entry & LZ_SCHEDULE_SLOT_TASK_ID_MASK;
+  Task *task;
+  lz_task_to_scheduler_message_t message;
+
+  if (LZ_SCHEDULE_SLOT_IDLE == taskId) {
+    return idleTask;
+  }
+
+  task = tasksById[taskId];
+  message = task->taskToSchedulerMessage;
+
+  /* Terminated and aborted tasks keep their message */
+  if (TERMINATE_TASK == message || ABORT_TASK == message) {
+    return idleTask;
+  }
+
+  if (entry & LZ_SCHEDULE_SLOT_JOB_START) {
+    task->timeUntilCompletion = task->completion;
+  }
+
+  /* The job is complete, the rest of its slots are left to the idle task */
+  if (0 == task->timeUntilCompletion) {
+    return idleTask;
+  }
+
+  return task;
+}
+
+/**
+ * Check the schedule table against the registered tasks, and index the tasks
+ * by ID.
+ *
+ * This is to be done once, before the time-triggered scheduler starts.
+ *
+ * @return
+ *         - _true_ if the schedule table is valid.
+ *         - _false_ if no schedule table is set, if a slot refers to a task
+ *           that is not a registered cyclic real-time task, or if there is not
+ *           enough memory.
+ */
+static bool
+PrepareScheduleTable(void)
+{
+  Task *task;
+  uint16_t slot;
+  uint8_t taskId;
+
+  if (NULL == scheduleTable) {
+    return false;
+  }
+
+  tasksById = KIncrementalMalloc(registeredTasksCount * sizeof(Task *));
+  if (NULL == tasksById) {
+    return false;
+  }
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    tasksById[task->id] = task;
+  }
+
+  for (slot = 0; slot < scheduleTableLength; ++slot) {
+    taskId = Arch_LoadU8FromProgmem(&scheduleTable[slot])
+      & LZ_SCHEDULE_SLOT_TASK_ID_MASK;
+
+    if (LZ_SCHEDULE_SLOT_IDLE != taskId &&
+        (taskId >= registeredTasksCount ||
+         CYCLIC_RT != tasksById[taskId]->schedulingPolicy)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Time-triggered scheduling function, used instead of Schedule() when the
+ * configuration option LZ_CONFIG_TIME_TRIGGERED_SCHEDULING is set.
+ *
+ * This function is called at each clock tick. It only reads the next slot of
+ * the schedule table: no task list is walked.
+ *
+ * A task can't wait for an interrupt, a software timer or a mutex, as it would
+ * run again in its next slot anyway, so such a wait calls Kernel_Panic().
+ */
+static void
+ScheduleTimeTriggered(void)
+{
+  const lz_task_to_scheduler_message_t message
+    = currentTask->taskToSchedulerMessage;
+
+  if (currentTask != idleTask) {
+    if (ABORT_TASK == message) {
+      List_Append(&abortedTasks, &currentTask->stateQueue);
+    } else if (TERMINATE_TASK == message) {
+      List_Append(&terminatedTasks, &currentTask->stateQueue);
+    } else if (WAIT_INTERRUPT == message ||
+               WAIT_SOFTWARE_TIMER == message ||
+               WAIT_MUTEX == message) {
+      Kernel_Panic();
+    } else {
+      if (WAIT_ACTIVATION == message) {
+        currentTask->timeUntilCompletion = 0;
+      } else {
+        --currentTask->timeUntilCompletion;
+      }
+
+      currentTask->taskToSchedulerMessage = NO_MESSAGE;
+    }
+  }
+
+  ++scheduleSlot;
+  if (scheduleSlot >= scheduleTableLength) {
+    scheduleSlot = 0;
+  }
+
+  currentTask = GetScheduleSlotTask(scheduleSlot);
 }
 
 /**
@@ -450,8 +1902,9 @@ CallbackRegisterUserTask(const Lz_TaskConfiguration * const taskConfiguration)
   bool (* const comparers[LZ_SCHEDULING_POLICY_MAX + 1]) (const Task * const,
                                                           const Task * const) =
     {
-      PeriodComparer,
-      PriorityComparer
+      DeadlineComparer,
+      PriorityComparer,
+      ArrivalComparer
     };
 
   if (taskConfiguration->schedulingPolicy > LZ_SCHEDULING_POLICY_MAX) {
@@ -459,7 +1912,23 @@ CallbackRegisterUserTask(const Lz_TaskConfiguration * const taskConfiguration)
   }
 
   if (CYCLIC_RT == taskConfiguration->schedulingPolicy &&
-      (0 == taskConfiguration->period || 0 == taskConfiguration->completion)) {
+      (0 == taskConfiguration->period ||
+       0 == taskConfiguration->completion ||
+       taskConfiguration->deadline > taskConfiguration->period ||
+       (taskConfiguration->offset >= taskConfiguration->period &&
+        (!LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS ||
+         LZ_RELEASE_OFFSET_AUTOMATIC != taskConfiguration->offset)))) {
+    return NULL;
+  }
+
+  if (LZ_CONFIG_TASK_BUDGETS &&
+      PRIORITY_RT == taskConfiguration->schedulingPolicy &&
+      taskConfiguration->budget > taskConfiguration->period) {
+    return NULL;
+  }
+
+  /* The schedule table releases the first jobs of all tasks */
+  if (LZ_CONFIG_TIME_TRIGGERED_SCHEDULING && 0 != taskConfiguration->offset) {
     return NULL;
   }
 
@@ -469,14 +1938,61 @@ CallbackRegisterUserTask(const Lz_TaskConfiguration * const taskConfiguration)
   }
 
   newTask->priority = taskConfiguration->priority;
+  newTask->quantum = 0 == taskConfiguration->quantum ?
+    1 : taskConfiguration->quantum;
+  newTask->timeUntilQuantumExpiration = newTask->quantum;
   newTask->period = taskConfiguration->period;
   newTask->completion = taskConfiguration->completion;
+  if (PRIORITY_RT == taskConfiguration->schedulingPolicy) {
+    newTask->completion = LZ_CONFIG_TASK_BUDGETS ?
+      taskConfiguration->budget : 0;
+  } else if (COOPERATIVE == taskConfiguration->schedulingPolicy) {
+    newTask->completion = 0;
+  }
+
+  newTask->deadline = 0 == taskConfiguration->deadline ?
+    taskConfiguration->period : taskConfiguration->deadline;
+  newTask->offset = taskConfiguration->offset;
 
   newTask->timeUntilActivation = newTask->period;
   newTask->timeUntilCompletion = newTask->completion;
 
+  newTask->jobStatistics = NULL;
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS &&
+      CYCLIC_RT == taskConfiguration->schedulingPolicy) {
+    newTask->jobStatistics = KIncrementalMalloc(sizeof(JobStatistics));
+    if (NULL == newTask->jobStatistics) {
+      return NULL;
+    }
+
+    /* The first job is released when the scheduler starts */
+    ResetJobStatistics(newTask->jobStatistics);
+    ReleaseJob(newTask->jobStatistics);
+  }
+
   List_InitLinkedListElement(&newTask->stateQueue);
 
+  /*
+   * The time-triggered scheduler elects tasks from the schedule table, so a
+   * task stays on no queue until it terminates or aborts.
+   */
+  if (LZ_CONFIG_TIME_TRIGGERED_SCHEDULING) {
+    return newTask;
+  }
+
+  if (CYCLIC_RT == taskConfiguration->schedulingPolicy &&
+      0 != newTask->offset &&
+      LZ_RELEASE_OFFSET_AUTOMATIC != newTask->offset) {
+    DelayFirstRelease(newTask, newTask->offset);
+
+    return newTask;
+  }
+
+  if (PRIORITY_RT == taskConfiguration->schedulingPolicy &&
+      newTask->completion > 0) {
+    ++budgetedTasksCount;
+  }
+
   InsertTaskByPriority(&readyTasks[taskConfiguration->schedulingPolicy],
                        newTask,
                        comparers[taskConfiguration->schedulingPolicy]);
@@ -498,6 +2014,8 @@ CallbackRegisterIdleTask(void)
     return NULL;
   }
 
+  idleTask->jobStatistics = NULL;
+
   return idleTask;
 }
 
@@ -552,11 +2070,21 @@ RegisterTask(void (* const taskEntryPoint)(void),
     /* Plus 1 call to save_context_on_stack (in startup.S) */
     + sizeof(void (*)(void));
 
-  taskStack = KIncrementalMalloc(desiredStackSize);
+  taskStack = KIncrementalMalloc(desiredStackSize + STACK_GUARD_SIZE);
   if (NULL == taskStack) {
     return false;
   }
 
+  if (LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW) {
+    /* The guard lies right below the lowest address of the stack */
+    *((uint16_t *)taskStack) = STACK_GUARD_WORD;
+    taskStack = ALLOW_ARITHM(taskStack) + STACK_GUARD_SIZE;
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_STACK_USAGE) {
+    PaintStack(taskStack, desiredStackSize);
+  }
+
   newTask->schedulingPolicy = taskConfiguration->schedulingPolicy;
   newTask->name = taskConfiguration->name;
   newTask->entryPoint = taskEntryPoint;
@@ -565,9 +2093,13 @@ RegisterTask(void (* const taskEntryPoint)(void),
   newTask->stackPointer = newTask->stackOrigin;
   newTask->timeUntilTimerExpiration = 0;
   newTask->taskToSchedulerMessage = NO_MESSAGE;
+  newTask->id = registeredTasksCount++;
 
   PrepareTaskContext(newTask);
 
+  List_InitLinkedListElement(&newTask->registeredTasksQueue);
+  List_Append(&registeredTasks, &newTask->registeredTasksQueue);
+
   return true;
 }
 
@@ -594,6 +2126,45 @@ RegisterIdleTask(void)
   return RegisterTask(IdleTask, &taskConfiguration, true);
 }
 
+/**
+ * Register the task running basic tasks, if basic tasks have been registered.
+ *
+ * This is to be done once, before the scheduler starts.
+ *
+ * @return
+ *         - _true_ if the task has been registered, or if there is no basic
+ *           task.
+ *         - _false_ if an error occurred during registration.
+ */
+static bool
+RegisterBasicTasksExecutive(void)
+{
+  Lz_TaskConfiguration taskConfiguration;
+
+  if (0 == basicTasksCount) {
+    return true;
+  }
+
+  Lz_TaskConfiguration_Init(&taskConfiguration);
+  taskConfiguration.name = "basic-tasks";
+  taskConfiguration.stackSize = LZ_CONFIG_BASIC_TASKS_STACK_SIZE;
+  taskConfiguration.priority = INT8_MAX;
+
+  if (!RegisterTask(BasicTasksDispatcher, &taskConfiguration, false)) {
+    return false;
+  }
+
+  basicTasksExecutive
+    = CONTAINER_OF(registeredTasks.last, registeredTasksQueue, Task);
+
+  /* The task is only ready while a basic task is activated or running */
+  List_Remove(&readyTasks[PRIORITY_RT], &basicTasksExecutive->stateQueue);
+  isBasicTasksExecutiveWaiting = true;
+  UpdateBasicTasksExecutive();
+
+  return true;
+}
+
 /**
  * @name Kernel API
  * @{
@@ -662,8 +2233,14 @@ Scheduler_AbortTask(void)
 void
 Scheduler_HandleInterrupt(const uint8_t interruptCode)
 {
+  Lz_BasicTask *basicTask;
   Task *loopTask;
   Lz_LinkedListElement *iterator;
+  uint32_t timestamp = 0;
+
+  if (LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED) {
+    timestamp = Scheduler_GetTimestamp();
+  }
 
   if (LZ_CONFIG_CHECK_INTERRUPT_CODE_OVER_LAST_ENTRY) {
     if (interruptCode > INT_LAST_ENTRY) {
@@ -671,6 +2248,12 @@ Scheduler_HandleInterrupt(const uint8_t interruptCode)
     }
   }
 
+  if (LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS) {
+    ++interruptsCounts[interruptCode];
+  }
+
+  TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_INTERRUPT, interruptCode);
+
   List_RemovableForEach(&waitingInterruptsTasks[interruptCode],
                         Task,
                         loopTask,
@@ -678,20 +2261,90 @@ Scheduler_HandleInterrupt(const uint8_t interruptCode)
                         iterator) {
     iterator = List_Remove(&waitingInterruptsTasks[interruptCode],
                            &loopTask->stateQueue);
-    InsertTaskByPriority(&readyTasks[PRIORITY_RT], loopTask, PriorityComparer);
+    if (LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED) {
+      interruptTimestamps[loopTask->id] = timestamp;
+    }
+    SetTaskReady(loopTask);
+    TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_TASK_WAKEUP, loopTask->id);
+  }
+
+  if (LZ_CONFIG_BASIC_TASKS) {
+    List_ForEach (&interruptBasicTasks,
+                  Lz_BasicTask,
+                  basicTask,
+                  activationQueue) {
+      if (interruptCode == basicTask->interruptCode) {
+        ActivateBasicTask(basicTask);
+      }
+    }
+  } else {
+    UNUSED(basicTask);
   }
 }
 
 void
 Scheduler_HandleClockTick(void * const sp)
 {
+  const Task * const previousTask = currentTask;
+
+  if (LZ_CONFIG_CHECK_TASK_STACK_OVERFLOW &&
+      Scheduler_IsStackOverflowed(currentTask, sp)) {
+    if (currentTask == idleTask) {
+      Kernel_Panic();
+    }
+
+    currentTask->taskToSchedulerMessage = ABORT_TASK;
+  }
+
   currentTask->stackPointer = sp;
 
+  if (TIMESTAMPS_USED) {
+    timestampBase += Arch_GetSystemTimerPeriod();
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_CPU_USAGE) {
+    AccountCpuTime();
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS &&
+      NULL != currentTask->jobStatistics) {
+    AccountJobExecutionTime(currentTask->jobStatistics, timestampBase);
+  }
+
+  if (LZ_CONFIG_MODULE_PROFILER_USED) {
+    SampleProgramCounter(sp);
+  }
+
   if (LZ_CONFIG_MODULE_CLOCK_24_USED) {
     Clock24_Increment();
   }
 
-  Schedule();
+  if (LZ_CONFIG_MODULE_TRACE_USED) {
+    Trace_IncrementTick();
+  }
+
+  if (LZ_CONFIG_TIME_TRIGGERED_SCHEDULING) {
+    ScheduleTimeTriggered();
+  } else {
+    Schedule();
+  }
+
+  if (currentTask != previousTask) {
+    TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_CONTEXT_SWITCH,
+                                    currentTask->id);
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS) {
+    UpdateKernelCounters(previousTask);
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+    RecordJobDispatch();
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_TASK_ID) {
+    Arch_InstrumentTaskId(currentTask->id);
+  }
 
   Arch_RestoreContextAndReturnFromInterrupt(currentTask->stackPointer);
 }
@@ -718,14 +2371,64 @@ Scheduler_WakeupTasksWaitingMutex(Lz_Mutex * const mutex)
                         iterator) {
     iterator = List_Remove(&mutex->waitingTasks,
                            &loopTask->stateQueue);
-    InsertTaskByPriority(&readyTasks[PRIORITY_RT], loopTask, PriorityComparer);
+    SetTaskReady(loopTask);
+    TRACE_POINT_INTERRUPTS_DISABLED(LZ_TRACE_EVENT_MUTEX_UNBLOCK, loopTask->id);
+  }
+}
+
+Task*
+Scheduler_GetCurrentTask(void)
+{
+  return currentTask;
+}
+
+size_t
+Scheduler_GetStackHighWaterMark(const Task * const task)
+{
+  const uint8_t * const stackEnd
+    = ALLOW_ARITHM(task->stackOrigin) - task->stackSize + 1;
+  size_t unusedBytes = 0;
+
+  while (unusedBytes < task->stackSize &&
+         STACK_PAINT_PATTERN == stackEnd[unusedBytes]) {
+    ++unusedBytes;
+  }
+
+  return task->stackSize - unusedBytes;
+}
+
+bool
+Scheduler_IsStackOverflowed(const Task * const task, const void * const sp)
+{
+  const uint8_t * const stackLimit
+    = ALLOW_ARITHM(task->stackOrigin) - task->stackSize;
+
+  if (STACK_GUARD_WORD != *((const uint16_t *)(stackLimit - 1))) {
+    return true;
   }
+
+  return (const uint8_t *)sp < stackLimit ||
+    (const uint8_t *)sp > (const uint8_t *)task->stackOrigin;
 }
 
-Task*
-Scheduler_GetCurrentTask(void)
-{
-  return currentTask;
+uint32_t
+Scheduler_GetTimestamp(void)
+{
+  const uint16_t counter = Arch_GetSystemTimerCounter();
+  const uint16_t period = Arch_GetSystemTimerPeriod();
+  uint32_t timestamp = timestampBase + counter;
+
+  /*
+   * If a clock tick is pending, the counter may have restarted from 0 while the
+   * time base has not been advanced yet. The tick flag is raised when the
+   * counter reaches the end of its period, so a high value of the counter means
+   * that it didn't restart yet.
+   */
+  if (Arch_IsSystemTimerTickPending() && counter < (period >> 1)) {
+    timestamp += period;
+  }
+
+  return timestamp;
 }
 
 void
@@ -739,10 +2442,57 @@ Scheduler_SleepUntilEndOfTimeSlice(void)
    * NO_MESSAGE only if the task's time slice has finished.
    */
   do {
+    if (LZ_CONFIG_INSTRUMENT_CPU_USAGE) {
+      RecordSleepTimestamp();
+    }
+
     Arch_CpuSleep();
   } while (NO_MESSAGE != currentTask->taskToSchedulerMessage);
 }
 
+Lz_BasicTask *
+Scheduler_StartBasicTask(void)
+{
+  Lz_BasicTask *basicTask = NULL;
+  InterruptsStatus interruptsStatus;
+
+  /* The clock tick reads the running basic task and the activated ones */
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  if (IsBasicTaskToStart()) {
+    basicTask = CONTAINER_OF(List_PickFirst(&pendingBasicTasks),
+                             pendingQueue,
+                             Lz_BasicTask);
+    basicTask->isPending = false;
+    basicTask->preemptedBasicTask = runningBasicTask;
+    runningBasicTask = basicTask;
+    isNewBasicTasksLevel = false;
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return basicTask;
+}
+
+void
+Scheduler_EndBasicTask(void)
+{
+  InterruptsStatus interruptsStatus;
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  runningBasicTask = runningBasicTask->preemptedBasicTask;
+  isNewBasicTasksLevel = true;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+uint8_t
+Scheduler_GetBasicTasksNestingLevel(void)
+{
+  return basicTasksNestingLevel;
+}
+
 /** @} */
 
 /** @name User API */
@@ -770,17 +2520,77 @@ Lz_RegisterTask(void (* const taskEntryPoint)(void),
 void
 Lz_Run(void)
 {
+  if (LZ_CONFIG_MODULE_TRACE_USED && !Trace_RegisterStreamTask()) {
+    Kernel_Panic();
+  }
+
+  if (LZ_CONFIG_BASIC_TASKS && !RegisterBasicTasksExecutive()) {
+    Kernel_Panic();
+  }
+
+  if (LZ_CONFIG_AUTOMATIC_RELEASE_OFFSETS) {
+    AssignReleaseOffsets();
+  }
+
+  if (LZ_CONFIG_CHECK_SCHEDULABILITY_AT_RUN) {
+    Lz_SchedulabilityAnalysis analysis;
+
+    Lz_AnalyzeSchedulability(&analysis, NULL, 0);
+    if (!analysis.isSchedulable) {
+      Kernel_Panic();
+    }
+  }
+
+  if (LZ_CONFIG_TASK_BUDGETS && !PrepareTaskBudgets()) {
+    Kernel_Panic();
+  }
+
   if (!RegisterIdleTask()) {
     Kernel_Panic();
   }
 
-  currentTask = PickTaskToRun();
+  if (!AllocateTaskCounters()) {
+    Kernel_Panic();
+  }
+
+  if (LZ_CONFIG_TIME_TRIGGERED_SCHEDULING) {
+    if (!PrepareScheduleTable()) {
+      Kernel_Panic();
+    }
+
+    currentTask = GetScheduleSlotTask(0);
+  } else {
+    currentTask = PickTaskToRun();
+  }
+
+  TRACE_POINT(LZ_TRACE_EVENT_CONTEXT_SWITCH, currentTask->id);
+
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+    RecordJobDispatch();
+  }
+
+  if (LZ_CONFIG_INSTRUMENT_TASK_ID) {
+    Arch_InstrumentTaskId(currentTask->id);
+  }
 
   Arch_StartSystemTimer();
 
   Arch_RestoreContextAndReturnFromInterrupt(currentTask->stackPointer);
 }
 
+bool
+Lz_SetScheduleTable(const uint8_t * const table, const uint16_t length)
+{
+  if (!LZ_CONFIG_TIME_TRIGGERED_SCHEDULING || NULL == table || 0 == length) {
+    return false;
+  }
+
+  scheduleTable = table;
+  scheduleTableLength = length;
+
+  return true;
+}
+
 const char *
 Lz_Task_GetName(void)
 {
@@ -790,6 +2600,29 @@ Lz_Task_GetName(void)
 void
 Lz_Task_WaitActivation(void)
 {
+  JobStatistics * const jobStatistics = currentTask->jobStatistics;
+  InterruptsStatus interruptsStatus;
+  uint32_t timestamp;
+
+  if (LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS && NULL != jobStatistics) {
+    interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+    if (!jobStatistics->isEnded) {
+      timestamp = Scheduler_GetTimestamp();
+      AccountJobExecutionTime(jobStatistics, timestamp);
+      AccumulateDuration(&jobStatistics->responseTime,
+                         timestamp - jobStatistics->releaseTimestamp);
+
+      if (UINT16_MAX != jobStatistics->jobsCount) {
+        ++jobStatistics->jobsCount;
+      }
+
+      EndJob(jobStatistics);
+    }
+
+    Arch_RestoreInterruptsStatus(interruptsStatus);
+  }
+
   currentTask->taskToSchedulerMessage = WAIT_ACTIVATION;
 
   Scheduler_SleepUntilEndOfTimeSlice();
@@ -804,6 +2637,11 @@ Lz_Task_WaitInterrupt(uint8_t interruptCode)
   currentTask->taskToSchedulerMessage = WAIT_INTERRUPT;
 
   Scheduler_SleepUntilEndOfTimeSlice();
+
+  if (LZ_CONFIG_MODULE_INTERRUPT_LATENCY_USED) {
+    InterruptLatency_Record(interruptCode,
+                            interruptTimestamps[currentTask->id]);
+  }
 }
 
 void
@@ -825,4 +2663,496 @@ Lz_Task_Terminate(void)
   Scheduler_SleepUntilEndOfTimeSlice();
 }
 
+void
+Lz_Task_Yield(void)
+{
+  currentTask->taskToSchedulerMessage = YIELD_TASK;
+
+  Scheduler_SleepUntilEndOfTimeSlice();
+}
+
+bool
+Lz_RegisterBasicTask(Lz_BasicTask * const basicTask,
+                     void (* const entryPoint)(void),
+                     const Lz_BasicTaskConfiguration * const configuration)
+{
+  if (!LZ_CONFIG_BASIC_TASKS || NULL == basicTask || NULL == entryPoint) {
+    return false;
+  }
+
+  if (NULL == configuration) {
+    basicTask->priority = 0;
+    basicTask->period = 0;
+    basicTask->interruptCode = 0;
+  } else {
+    if ((configuration->period > 0 && configuration->interruptCode > 0) ||
+        configuration->interruptCode > INT_LAST_ENTRY) {
+      return false;
+    }
+
+    basicTask->priority = configuration->priority;
+    basicTask->period = configuration->period;
+    basicTask->interruptCode = configuration->interruptCode;
+  }
+
+  basicTask->entryPoint = entryPoint;
+  basicTask->preemptedBasicTask = NULL;
+  basicTask->stackPointer = NULL;
+  basicTask->timeUntilActivation = basicTask->period;
+  basicTask->isPending = false;
+  List_InitLinkedListElement(&basicTask->activationQueue);
+  List_InitLinkedListElement(&basicTask->pendingQueue);
+
+  if (basicTask->period > 0) {
+    List_Append(&periodicBasicTasks, &basicTask->activationQueue);
+
+    /* Like cyclic tasks, the first activation is when the scheduler starts */
+    ActivateBasicTask(basicTask);
+  } else if (basicTask->interruptCode > 0) {
+    List_Append(&interruptBasicTasks, &basicTask->activationQueue);
+  }
+
+  ++basicTasksCount;
+
+  return true;
+}
+
+bool
+Lz_BasicTask_Activate(Lz_BasicTask * const basicTask)
+{
+  InterruptsStatus interruptsStatus;
+  bool isActivated;
+
+  if (!LZ_CONFIG_BASIC_TASKS || NULL == basicTask) {
+    return false;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+  isActivated = ActivateBasicTask(basicTask);
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return isActivated;
+}
+
+size_t
+Lz_Task_GetStackHighWaterMark(void)
+{
+  if (!LZ_CONFIG_INSTRUMENT_STACK_USAGE) {
+    return 0;
+  }
+
+  return Scheduler_GetStackHighWaterMark(currentTask);
+}
+
+uint8_t
+Lz_GetTasksStackUsage(Lz_TaskStackUsage * const stackUsages,
+                      const uint8_t tableSize)
+{
+  Task *task;
+  uint8_t count = 0;
+
+  if (!LZ_CONFIG_INSTRUMENT_STACK_USAGE || NULL == stackUsages) {
+    return 0;
+  }
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    if (count >= tableSize) {
+      break;
+    }
+
+    stackUsages[count].name = task->name;
+    stackUsages[count].stackSize = task->stackSize;
+    stackUsages[count].maxUsed = Scheduler_GetStackHighWaterMark(task);
+
+    ++count;
+  }
+
+  return count;
+}
+
+uint8_t
+Lz_GetTasksCpuUsage(Lz_TaskCpuUsage * const cpuUsages, const uint8_t tableSize)
+{
+  Task *task;
+  InterruptsStatus interruptsStatus;
+  uint32_t totalCpuTime = 0;
+  uint32_t onePercent;
+  uint32_t percentage;
+  uint8_t count = 0;
+  uint8_t i;
+
+  /* The counters are allocated when the scheduler starts */
+  if (!LZ_CONFIG_INSTRUMENT_CPU_USAGE ||
+      NULL == cpuUsages ||
+      NULL == cpuTimes) {
+    return 0;
+  }
+
+  /* The counters are updated by the scheduler, so we read them atomically */
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    totalCpuTime += cpuTimes[task->id];
+
+    if (count < tableSize) {
+      cpuUsages[count].name = task->name;
+      cpuUsages[count].cpuTime = cpuTimes[task->id];
+
+      ++count;
+    }
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  /*
+   * Multiplying by 100 before dividing by the total is exact, but can overflow
+   * for large totals. Then we divide by 1% of the total rounded up, so that the
+   * percentage can't exceed 100.
+   */
+  onePercent = 0;
+  if (totalCpuTime > UINT32_MAX / 100) {
+    onePercent = DivideRoundUp(totalCpuTime, 100);
+  }
+
+  for (i = 0; i < count; ++i) {
+    if (0 == totalCpuTime) {
+      percentage = 0;
+    } else if (0 == onePercent) {
+      percentage =
+        Arch_Divide_U32(Arch_Multiply_U32(cpuUsages[i].cpuTime, 100),
+                        totalCpuTime).quotient;
+    } else {
+      percentage = Arch_Divide_U32(cpuUsages[i].cpuTime, onePercent).quotient;
+    }
+
+    cpuUsages[i].percentage = (uint8_t)MIN(percentage, 100);
+  }
+
+  return count;
+}
+
+void
+Lz_ResetTasksCpuUsage(void)
+{
+  InterruptsStatus interruptsStatus;
+  uint8_t i;
+
+  if (!LZ_CONFIG_INSTRUMENT_CPU_USAGE || NULL == cpuTimes) {
+    return;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  for (i = 0; i < registeredTasksCount; ++i) {
+    cpuTimes[i] = 0;
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+uint8_t
+Lz_GetCyclicTasksStatistics(Lz_CyclicTaskStatistics * const statistics,
+                            const uint8_t tableSize)
+{
+  Task *task;
+  JobStatistics jobStatistics;
+  InterruptsStatus interruptsStatus;
+  uint8_t count = 0;
+
+  if (!LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS || NULL == statistics) {
+    return 0;
+  }
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    if (count >= tableSize) {
+      break;
+    }
+
+    if (NULL == task->jobStatistics) {
+      continue;
+    }
+
+    /* The statistics are updated by the scheduler, so we copy them at once */
+    interruptsStatus = Arch_DisableInterruptsGetStatus();
+    Memory_Copy(task->jobStatistics, &jobStatistics, sizeof(JobStatistics));
+    Arch_RestoreInterruptsStatus(interruptsStatus);
+
+    statistics[count].name = task->name;
+    statistics[count].completionTime =
+      Arch_Multiply_U32(task->completion, Arch_GetSystemTimerPeriod());
+    statistics[count].maxExecutionTime = jobStatistics.maxExecutionTime;
+    GetDurationStatistics(&jobStatistics.releaseJitter,
+                          &statistics[count].releaseJitter);
+    GetDurationStatistics(&jobStatistics.responseTime,
+                          &statistics[count].responseTime);
+    statistics[count].jobsCount = jobStatistics.jobsCount;
+    statistics[count].overrunsCount = jobStatistics.overrunsCount;
+    statistics[count].deadlineMissesCount = jobStatistics.deadlineMissesCount;
+
+    ++count;
+  }
+
+  return count;
+}
+
+void
+Lz_ResetCyclicTasksStatistics(void)
+{
+  Task *task;
+  InterruptsStatus interruptsStatus;
+
+  if (!LZ_CONFIG_INSTRUMENT_CYCLIC_TASKS) {
+    return;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    if (NULL != task->jobStatistics) {
+      ResetJobStatistics(task->jobStatistics);
+    }
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+uint8_t
+Lz_AnalyzeSchedulability(Lz_SchedulabilityAnalysis * const analysis,
+                         Lz_TaskResponseTime * const responseTimes,
+                         const uint8_t tableSize)
+{
+  Task *task;
+  uint32_t responseTime;
+  uint32_t utilization = 0;
+  const uint16_t period = Arch_GetSystemTimerPeriod();
+  const uint16_t overhead = LZ_CONFIG_CLOCK_TICK_OVERHEAD < period ?
+    LZ_CONFIG_CLOCK_TICK_OVERHEAD : period;
+  uint8_t count = 0;
+  bool hasConstrainedDeadlines = false;
+
+  if (!LZ_CONFIG_SCHEDULABILITY_ANALYSIS || NULL == analysis) {
+    return 0;
+  }
+
+  analysis->cyclicTasksCount = 0;
+  analysis->isSchedulable = true;
+
+  List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+    if (CYCLIC_RT != task->schedulingPolicy) {
+      continue;
+    }
+
+    ++analysis->cyclicTasksCount;
+    if (task->deadline < task->period) {
+      hasConstrainedDeadlines = true;
+    }
+
+    utilization += DivideRoundUp(Arch_Multiply_U32(task->completion, 1000),
+                                 task->period);
+
+    responseTime = ComputeResponseTime(task);
+    if (responseTime > task->deadline) {
+      analysis->isSchedulable = false;
+    }
+
+    if (NULL != responseTimes && count < tableSize) {
+      responseTimes[count].name = task->name;
+      responseTimes[count].period = task->period;
+      responseTimes[count].completion = task->completion;
+      responseTimes[count].deadline = task->deadline;
+      responseTimes[count].responseTime = responseTime;
+      responseTimes[count].availableExecutionTime =
+        Arch_Multiply_U32(task->completion, period - overhead);
+      responseTimes[count].isSchedulable = responseTime <= task->deadline;
+
+      ++count;
+    }
+  }
+
+  analysis->cyclicUtilization =
+    utilization < UINT16_MAX ? (uint16_t)utilization : UINT16_MAX;
+  analysis->tickOverhead =
+    (uint16_t)DivideRoundUp(Arch_Multiply_U32(overhead, 1000), period);
+
+  /* Clock ticks also happen in the time slices left to other tasks */
+  analysis->cpuLoad = analysis->cyclicUtilization;
+  if (analysis->cyclicUtilization < 1000) {
+    analysis->cpuLoad +=
+      (uint16_t)DivideRoundUp(Arch_Multiply_U32(analysis->tickOverhead,
+                                                1000 - utilization),
+                              1000);
+  }
+
+  if (0 == analysis->cyclicTasksCount) {
+    analysis->liuLaylandBound = 1000;
+  } else if (analysis->cyclicTasksCount <= ELEMENTS_COUNT(LiuLaylandBounds)) {
+    analysis->liuLaylandBound = Arch_LoadU16FromProgmem(
+      &LiuLaylandBounds[analysis->cyclicTasksCount - 1]);
+  } else {
+    analysis->liuLaylandBound = LIU_LAYLAND_BOUND_LIMIT;
+  }
+
+  /* The Liu-Layland bound only applies to deadlines equal to periods */
+  analysis->isUnderLiuLaylandBound = !hasConstrainedDeadlines &&
+    analysis->cyclicUtilization <= analysis->liuLaylandBound;
+
+  return count;
+}
+
+void
+Lz_GetLongestCriticalSection(Lz_CriticalSection * const criticalSection)
+{
+  InterruptsStatus interruptsStatus;
+
+  if (NULL == criticalSection) {
+    return;
+  }
+
+  if (!LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS) {
+    criticalSection->duration = 0;
+    criticalSection->location = 0;
+    criticalSection->interruptCode = LZ_CRITICAL_SECTION_NO_INTERRUPT;
+
+    return;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+  Arch_GetLongestCriticalSection(criticalSection);
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+void
+Lz_ResetLongestCriticalSection(void)
+{
+  InterruptsStatus interruptsStatus;
+
+  if (!LZ_CONFIG_INSTRUMENT_CRITICAL_SECTIONS) {
+    return;
+  }
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+  Arch_ResetLongestCriticalSection();
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+}
+
+uint8_t
+Lz_GetKernelSnapshot(Lz_KernelSnapshot * const snapshot,
+                     Lz_TaskSnapshot * const tasks,
+                     const uint8_t tableSize)
+{
+  Task *task;
+  InterruptsStatus interruptsStatus;
+  uint8_t count = 0;
+  uint8_t i;
+
+  if (NULL == snapshot) {
+    return 0;
+  }
+
+  /* The whole snapshot is taken atomically, so it is consistent */
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+
+  if (LZ_CONFIG_INSTRUMENT_KERNEL_COUNTERS) {
+    snapshot->ticksCount = ticksCount;
+    snapshot->contextSwitchesCount = contextSwitchesCount;
+    snapshot->idleTicksCount = idleTicksCount;
+    Memory_Copy(interruptsCounts,
+                snapshot->interruptsCounts,
+                sizeof(interruptsCounts));
+  } else {
+    snapshot->ticksCount = 0;
+    snapshot->contextSwitchesCount = 0;
+    snapshot->idleTicksCount = 0;
+
+    for (i = 0; i < INT_TOTAL; ++i) {
+      snapshot->interruptsCounts[i] = 0;
+    }
+  }
+
+  snapshot->tasksCount = registeredTasksCount;
+
+  if (NULL != tasks) {
+    /*
+     * Task IDs are attributed in order of registration, so they are the indexes
+     * of the tasks in the table.
+     */
+    List_ForEach (&registeredTasks, Task, task, registeredTasksQueue) {
+      if (count >= tableSize) {
+        break;
+      }
+
+      tasks[count].name = task->name;
+      tasks[count].schedulingPolicy = task->schedulingPolicy;
+      tasks[count].priority = task->priority;
+      tasks[count].interruptCode = LZ_TASK_SNAPSHOT_NO_INTERRUPT;
+
+      /*
+       * The running task and the idle task are on no queue. Tasks waiting for
+       * a mutex are on the queue of the mutex, that is not known here. So
+       * every task that is not found on a queue of the scheduler is waiting
+       * for a mutex, except with the time-triggered scheduler, where tasks
+       * that neither terminated nor aborted are on no queue.
+       */
+      if (task == currentTask) {
+        tasks[count].state = LZ_TASK_STATE_RUNNING;
+      } else if (task == basicTasksExecutive &&
+                 isBasicTasksExecutiveWaiting) {
+        tasks[count].state = LZ_TASK_STATE_WAITING_ACTIVATION;
+      } else if (task == idleTask || LZ_CONFIG_TIME_TRIGGERED_SCHEDULING) {
+        tasks[count].state = LZ_TASK_STATE_READY;
+      } else {
+        tasks[count].state = LZ_TASK_STATE_WAITING_MUTEX;
+      }
+
+      ++count;
+    }
+
+    for (i = 0; i < ELEMENTS_COUNT(readyTasks); ++i) {
+      SnapshotTasksState(&readyTasks[i],
+                         LZ_TASK_STATE_READY,
+                         LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                         tasks,
+                         count);
+    }
+
+    for (i = 0; i < ELEMENTS_COUNT(waitingInterruptsTasks); ++i) {
+      SnapshotTasksState(&waitingInterruptsTasks[i],
+                         LZ_TASK_STATE_WAITING_INTERRUPT,
+                         i,
+                         tasks,
+                         count);
+    }
+
+    SnapshotTasksState(&waitingActivationTasks,
+                       LZ_TASK_STATE_WAITING_ACTIVATION,
+                       LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                       tasks,
+                       count);
+    SnapshotTasksState(&waitingTimerTasks,
+                       LZ_TASK_STATE_WAITING_TIMER,
+                       LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                       tasks,
+                       count);
+    SnapshotTasksState(&terminatedTasks,
+                       LZ_TASK_STATE_TERMINATED,
+                       LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                       tasks,
+                       count);
+    SnapshotTasksState(&abortedTasks,
+                       LZ_TASK_STATE_ABORTED,
+                       LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                       tasks,
+                       count);
+    SnapshotTasksState(&throttledTasks,
+                       LZ_TASK_STATE_THROTTLED,
+                       LZ_TASK_SNAPSHOT_NO_INTERRUPT,
+                       tasks,
+                       count);
+  }
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  return count;
+}
+
 /** @} */
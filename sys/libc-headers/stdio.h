@@ -15,6 +15,7 @@
 #define STDIO_H
 
 #include <Lazuli/common.h>
+#include <Lazuli/sys/compiler.h>
 
 _EXTERN_C_DECL_BEGIN
 
@@ -36,6 +37,11 @@ _EXTERN_C_DECL_BEGIN
  *
  * A decimal digit string can be used to specify a minimum field width.
  *
+ * # Length modifier
+ *
+ * **l**        The following integer conversion corresponds to a *long int*
+ *              or *unsigned long int* argument.
+ *
  * # Conversion specifiers
  *
  * The following conversion specifiers are currently allowed:
@@ -58,6 +64,26 @@ _EXTERN_C_DECL_BEGIN
 int
 printf(const char * format, ...);
 
+/**
+ * Produce unbuffered formatted output to the serial line, with the format
+ * string stored in program memory.
+ *
+ * This function behaves like printf(), except that the format string, and the
+ * strings passed as arguments of the **s** conversion specifier, are read from
+ * program memory. Such strings can be declared with PSTR().
+ *
+ * @param format The format string, stored in program memory.
+ * @param ... The variadic parameters.
+ *
+ * @return The number of characters output to the serial line, or a negative
+ *         value if an error occurred.
+ *
+ * @warning The stack usage of this function is important.
+ *          No locking mechanism is provided.
+ */
+int
+printf_P(const char * format, ...);
+
 /**
  * Transmit a single character on the serial line.
  *
@@ -86,6 +112,21 @@ putchar(int c);
 int
 puts(const char *s);
 
+/**
+ * Transmit the NUL-terminated string @p s, stored in program memory, followed
+ * by a trailing newline on the serial line, without any formatting.
+ *
+ * @param s The string to transmit, stored in program memory. Such a string can
+ *          be declared with PSTR().
+ *
+ * @return A non-negative number on success, otherwise EOF on error.
+ *
+ * @warning This operation is not thread safe.
+ *          No locking mechanism is provided.
+ */
+int
+puts_P(const char *s);
+
 _EXTERN_C_DECL_END
 
 #endif /* STDIO_H */
@@ -32,6 +32,90 @@ _EXTERN_C_DECL_BEGIN
 size_t
 strlen(const char *s);
 
+/**
+ * Copy @p n bytes from memory area @p src to memory area @p dest.
+ *
+ * @param dest A pointer to the destination memory area.
+ * @param src A pointer to the source memory area.
+ * @param n The number of bytes to copy.
+ *
+ * @return The pointer @p dest.
+ *
+ * @warning The memory areas must not overlap. Use memmove() if they do.
+ */
+void *
+memcpy(void *dest, const void *src, size_t n);
+
+/**
+ * Copy @p n bytes from memory area @p src to memory area @p dest, the memory
+ * areas may overlap.
+ *
+ * @param dest A pointer to the destination memory area.
+ * @param src A pointer to the source memory area.
+ * @param n The number of bytes to copy.
+ *
+ * @return The pointer @p dest.
+ */
+void *
+memmove(void *dest, const void *src, size_t n);
+
+/**
+ * Fill the first @p n bytes of the memory area pointed by @p s with the
+ * constant byte @p c.
+ *
+ * @param s A pointer to the memory area to fill.
+ * @param c The value to fill the memory area with, that will be cast to an
+ *          unsigned char.
+ * @param n The number of bytes to fill.
+ *
+ * @return The pointer @p s.
+ */
+void *
+memset(void *s, int c, size_t n);
+
+/**
+ * Compare the first @p n bytes of the memory areas @p s1 and @p s2.
+ *
+ * @param s1 A pointer to the first memory area.
+ * @param s2 A pointer to the second memory area.
+ * @param n The number of bytes to compare.
+ *
+ * @return The difference between the first pair of bytes that differ, both
+ *         interpreted as unsigned char, or 0 if the memory areas are equal.
+ */
+int
+memcmp(const void *s1, const void *s2, size_t n);
+
+/**
+ * Compare the two strings @p s1 and @p s2.
+ *
+ * @param s1 A pointer to the first NUL-terminated string.
+ * @param s2 A pointer to the second NUL-terminated string.
+ *
+ * @return The difference between the first pair of characters that differ,
+ *         both interpreted as unsigned char, or 0 if the strings are equal.
+ */
+int
+strcmp(const char *s1, const char *s2);
+
+/**
+ * Copy at most @p n characters of the string @p src to @p dest.
+ *
+ * If @p src is shorter than @p n characters, @p dest is padded with NUL
+ * characters until a total of @p n characters have been written.
+ *
+ * @param dest A pointer to the destination buffer.
+ * @param src A pointer to the source NUL-terminated string.
+ * @param n The number of characters to write to @p dest.
+ *
+ * @return The pointer @p dest.
+ *
+ * @warning If there is no NUL character among the first @p n characters of
+ *          @p src, the string placed in @p dest will not be NUL-terminated.
+ */
+char *
+strncpy(char *dest, const char *src, size_t n);
+
 _EXTERN_C_DECL_END
 
 #endif /* STRING_H */
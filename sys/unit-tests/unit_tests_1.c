@@ -24,6 +24,7 @@
 #include <Lazuli/common.h>
 #include <Lazuli/config.h>
 
+#include <Lazuli/sys/compiler.h>
 #include <Lazuli/sys/printf.h>
 
 DEPENDENCY_ON_MODULE(PRINTF);
@@ -443,6 +444,157 @@ UNIT_TEST(ConvertU16ToDecimal_12)
   ASSERT('1' == buffer[3]);
 }
 
+UNIT_TEST(ConvertU32ToDecimal_1)
+{
+  const uint32_t i = 0UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(1 == size);
+  ASSERT('0' == buffer[0]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_2)
+{
+  const uint32_t i = 7UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(1 == size);
+  ASSERT('7' == buffer[0]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_3)
+{
+  const uint32_t i = 65535UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(5 == size);
+  ASSERT('5' == buffer[0]);
+  ASSERT('3' == buffer[1]);
+  ASSERT('5' == buffer[2]);
+  ASSERT('5' == buffer[3]);
+  ASSERT('6' == buffer[4]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_4)
+{
+  const uint32_t i = 65536UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(5 == size);
+  ASSERT('6' == buffer[0]);
+  ASSERT('3' == buffer[1]);
+  ASSERT('5' == buffer[2]);
+  ASSERT('5' == buffer[3]);
+  ASSERT('6' == buffer[4]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_5)
+{
+  const uint32_t i = 99999UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(5 == size);
+  ASSERT('9' == buffer[0]);
+  ASSERT('9' == buffer[1]);
+  ASSERT('9' == buffer[2]);
+  ASSERT('9' == buffer[3]);
+  ASSERT('9' == buffer[4]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_6)
+{
+  const uint32_t i = 100000UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(6 == size);
+  ASSERT('0' == buffer[0]);
+  ASSERT('0' == buffer[1]);
+  ASSERT('0' == buffer[2]);
+  ASSERT('0' == buffer[3]);
+  ASSERT('0' == buffer[4]);
+  ASSERT('1' == buffer[5]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_7)
+{
+  const uint32_t i = 1234567890UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(10 == size);
+  ASSERT('0' == buffer[0]);
+  ASSERT('9' == buffer[1]);
+  ASSERT('8' == buffer[2]);
+  ASSERT('7' == buffer[3]);
+  ASSERT('6' == buffer[4]);
+  ASSERT('5' == buffer[5]);
+  ASSERT('4' == buffer[6]);
+  ASSERT('3' == buffer[7]);
+  ASSERT('2' == buffer[8]);
+  ASSERT('1' == buffer[9]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_8)
+{
+  const uint32_t i = 4294967295UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(10 == size);
+  ASSERT('5' == buffer[0]);
+  ASSERT('9' == buffer[1]);
+  ASSERT('2' == buffer[2]);
+  ASSERT('7' == buffer[3]);
+  ASSERT('6' == buffer[4]);
+  ASSERT('9' == buffer[5]);
+  ASSERT('4' == buffer[6]);
+  ASSERT('9' == buffer[7]);
+  ASSERT('2' == buffer[8]);
+  ASSERT('4' == buffer[9]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_9)
+{
+  const uint32_t i = 16777216UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(8 == size);
+  ASSERT('6' == buffer[0]);
+  ASSERT('1' == buffer[1]);
+  ASSERT('2' == buffer[2]);
+  ASSERT('7' == buffer[3]);
+  ASSERT('7' == buffer[4]);
+  ASSERT('7' == buffer[5]);
+  ASSERT('6' == buffer[6]);
+  ASSERT('1' == buffer[7]);
+}
+
+UNIT_TEST(ConvertU32ToDecimal_10)
+{
+  const uint32_t i = 1000000000UL;
+  char buffer[10];
+  const uint8_t size = Printf_ConvertU32ToDecimal(i, buffer);
+
+  ASSERT(10 == size);
+  ASSERT('0' == buffer[0]);
+  ASSERT('0' == buffer[1]);
+  ASSERT('0' == buffer[2]);
+  ASSERT('0' == buffer[3]);
+  ASSERT('0' == buffer[4]);
+  ASSERT('0' == buffer[5]);
+  ASSERT('0' == buffer[6]);
+  ASSERT('0' == buffer[7]);
+  ASSERT('0' == buffer[8]);
+  ASSERT('1' == buffer[9]);
+}
+
 UNIT_TEST(Printf_1)
 {
   int total;
@@ -1160,6 +1312,244 @@ UNIT_TEST(Printf_55)
   ASSERT(9 == total);
 }
 
+UNIT_TEST(Printf_56)
+{
+  int total;
+
+  OutputRawString("C:4294967295:");
+
+  total = printf("%lu", 4294967295UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(10 == total);
+}
+
+UNIT_TEST(Printf_57)
+{
+  int total;
+
+  OutputRawString("C:2147483647:");
+
+  total = printf("%ld", 2147483647L);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(10 == total);
+}
+
+UNIT_TEST(Printf_58)
+{
+  int total;
+
+  OutputRawString("C:-2147483647:");
+
+  total = printf("%li", -2147483647L);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(11 == total);
+}
+
+UNIT_TEST(Printf_59)
+{
+  int total;
+
+  OutputRawString("C:0:");
+
+  total = printf("%lu", 0UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(1 == total);
+}
+
+UNIT_TEST(Printf_60)
+{
+  int total;
+
+  OutputRawString("C:-70000:");
+
+  total = printf("%ld", -70000L);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(6 == total);
+}
+
+UNIT_TEST(Printf_61)
+{
+  int total;
+
+  OutputRawString("C:ffffffff:");
+
+  total = printf("%lx", 0xffffffffUL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(8 == total);
+}
+
+UNIT_TEST(Printf_62)
+{
+  int total;
+
+  OutputRawString("C:DEADBEEF:");
+
+  total = printf("%lX", 0xdeadbeefUL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(8 == total);
+}
+
+UNIT_TEST(Printf_63)
+{
+  int total;
+
+  OutputRawString("C:37777777777:");
+
+  total = printf("%lo", 0xffffffffUL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(11 == total);
+}
+
+UNIT_TEST(Printf_64)
+{
+  int total;
+
+  OutputRawString("C:0000123456:");
+
+  total = printf("%010lu", 123456UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(10 == total);
+}
+
+UNIT_TEST(Printf_65)
+{
+  int total;
+
+  OutputRawString("C:-000123456:");
+
+  total = printf("%010ld", -123456L);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(10 == total);
+}
+
+UNIT_TEST(Printf_66)
+{
+  int total;
+
+  OutputRawString("C:123456    |:");
+
+  total = printf("%-10lu|", 123456UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(11 == total);
+}
+
+UNIT_TEST(Printf_67)
+{
+  int total;
+
+  OutputRawString("C:65536 12 10000:");
+
+  total = printf("%lu %d %lx", 65536UL, 12, 0x10000UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(14 == total);
+}
+
+UNIT_TEST(Printf_P_1)
+{
+  int total;
+
+  OutputRawString("C:flash 12:");
+
+  total = printf_P(PSTR("flash %d"), 12);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(8 == total);
+}
+
+UNIT_TEST(Printf_P_2)
+{
+  int total;
+
+  OutputRawString("C:4294967295:");
+
+  total = printf_P(PSTR("%lu"), 4294967295UL);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(10 == total);
+}
+
+UNIT_TEST(Printf_P_3)
+{
+  int total;
+
+  OutputRawString("C:ab|   cd:");
+
+  total = printf_P(PSTR("%s|%5s"), PSTR("ab"), PSTR("cd"));
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(8 == total);
+}
+
+UNIT_TEST(Printf_P_4)
+{
+  int total;
+
+  OutputRawString("C:cd   |:");
+
+  total = printf_P(PSTR("%-5s|"), PSTR("cd"));
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(6 == total);
+}
+
+UNIT_TEST(Printf_P_5)
+{
+  int total;
+
+  OutputRawString("C:0x00fe%:");
+
+  total = printf_P(PSTR("0x%04x%%"), 0xfe);
+
+  OutputRawString(LZ_CONFIG_SERIAL_NEWLINE);
+
+  ASSERT(7 == total);
+}
+
+UNIT_TEST(Printf_P_6)
+{
+  ASSERT(0 == printf_P(NULL));
+}
+
+UNIT_TEST(Puts_P_1)
+{
+  OutputRawString("C:puts_P:");
+
+  ASSERT(EOF != puts_P(PSTR("puts_P:")));
+}
+
+UNIT_TEST(Puts_P_2)
+{
+  ASSERT(EOF == puts_P(NULL));
+}
+
 void
 ExecuteTests(void)
 {
@@ -1180,6 +1570,16 @@ ExecuteTests(void)
   ConvertU16ToDecimal_10();
   ConvertU16ToDecimal_11();
   ConvertU16ToDecimal_12();
+  ConvertU32ToDecimal_1();
+  ConvertU32ToDecimal_2();
+  ConvertU32ToDecimal_3();
+  ConvertU32ToDecimal_4();
+  ConvertU32ToDecimal_5();
+  ConvertU32ToDecimal_6();
+  ConvertU32ToDecimal_7();
+  ConvertU32ToDecimal_8();
+  ConvertU32ToDecimal_9();
+  ConvertU32ToDecimal_10();
   Printf_1();
   Printf_2();
   Printf_3();
@@ -1235,4 +1635,24 @@ ExecuteTests(void)
   Printf_53();
   Printf_54();
   Printf_55();
+  Printf_56();
+  Printf_57();
+  Printf_58();
+  Printf_59();
+  Printf_60();
+  Printf_61();
+  Printf_62();
+  Printf_63();
+  Printf_64();
+  Printf_65();
+  Printf_66();
+  Printf_67();
+  Printf_P_1();
+  Printf_P_2();
+  Printf_P_3();
+  Printf_P_4();
+  Printf_P_5();
+  Printf_P_6();
+  Puts_P_1();
+  Puts_P_2();
 }
@@ -23,6 +23,7 @@
 #include <Lazuli/sys/arch/arch.h>
 #include <Lazuli/sys/compiler.h>
 #include <Lazuli/sys/scheduler.h>
+#include <Lazuli/sys/task.h>
 
 DEPENDENCY_ON_MODULE(DIVISION);
 DEPENDENCY_ON_MODULE(SERIAL);
@@ -973,6 +974,61 @@ UNIT_TEST(List_AppendList_4)
   ASSERT(NULL == List_PointFirst(&linkedList2));
 }
 
+UNIT_TEST(List_InsertBefore_1)
+{
+  Lz_LinkedList linkedList = LINKED_LIST_INIT;
+  TestListItem a = { 'A', LINKED_LIST_ELEMENT_INIT };
+  TestListItem b = { 'B', LINKED_LIST_ELEMENT_INIT };
+  TestListItem c = { 'C', LINKED_LIST_ELEMENT_INIT };
+  TestListItem *item;
+  char testChar = 'A';
+
+  List_Append(&linkedList, &a.element);
+  List_Append(&linkedList, &c.element);
+
+  /* Insert in the middle of the list */
+  List_InsertBefore(&linkedList, &c.element, &b.element);
+
+  List_ForEach(&linkedList, TestListItem, item, element) {
+    ASSERT(testChar == item->c);
+    ++testChar;
+  }
+
+  ASSERT('D' == testChar);
+  ASSERT(&b.element == a.element.next);
+  ASSERT(&a.element == b.element.prev);
+  ASSERT(&c.element == b.element.next);
+  ASSERT(&b.element == c.element.prev);
+  ASSERT(&a.element == List_PointFirst(&linkedList));
+}
+
+UNIT_TEST(List_InsertAfter_1)
+{
+  Lz_LinkedList linkedList = LINKED_LIST_INIT;
+  TestListItem a = { 'A', LINKED_LIST_ELEMENT_INIT };
+  TestListItem b = { 'B', LINKED_LIST_ELEMENT_INIT };
+  TestListItem c = { 'C', LINKED_LIST_ELEMENT_INIT };
+  TestListItem *item;
+  char testChar = 'A';
+
+  List_Append(&linkedList, &a.element);
+  List_Append(&linkedList, &c.element);
+
+  /* Insert in the middle of the list */
+  List_InsertAfter(&linkedList, &a.element, &b.element);
+
+  List_ForEach(&linkedList, TestListItem, item, element) {
+    ASSERT(testChar == item->c);
+    ++testChar;
+  }
+
+  ASSERT('D' == testChar);
+  ASSERT(&b.element == a.element.next);
+  ASSERT(&a.element == b.element.prev);
+  ASSERT(&c.element == b.element.next);
+  ASSERT(&b.element == c.element.prev);
+}
+
 UNIT_TEST(Division_1)
 {
   const unsigned int numerator = 15;
@@ -1567,6 +1623,228 @@ UNIT_TEST(Division_35)
   ASSERT(numerator == denominator * d.quotient + d.remainder);
 }
 
+/**
+ * Initialize a Task whose stack is the buffer @p stack, painted with
+ * STACK_PAINT_PATTERN.
+ *
+ * @param task A pointer to the Task to initialize.
+ * @param stack A pointer to the buffer to use as stack.
+ * @param size The size of the buffer @p stack.
+ */
+static void
+InitPaintedTask(Task * const task, uint8_t * const stack, const size_t size)
+{
+  size_t i;
+
+  for (i = 0; i < size; ++i) {
+    stack[i] = STACK_PAINT_PATTERN;
+  }
+
+  task->stackSize = size;
+  task->stackOrigin = &stack[size - 1];
+}
+
+UNIT_TEST(StackHighWaterMark_1)
+{
+  Task task;
+  uint8_t stack[16];
+
+  InitPaintedTask(&task, stack, sizeof(stack));
+
+  ASSERT(0 == Scheduler_GetStackHighWaterMark(&task));
+}
+
+UNIT_TEST(StackHighWaterMark_2)
+{
+  Task task;
+  uint8_t stack[16];
+
+  InitPaintedTask(&task, stack, sizeof(stack));
+  stack[15] = 0x00;
+  stack[14] = 0x12;
+  stack[13] = 0x00;
+
+  ASSERT(3 == Scheduler_GetStackHighWaterMark(&task));
+}
+
+UNIT_TEST(StackHighWaterMark_3)
+{
+  Task task;
+  uint8_t stack[16];
+
+  InitPaintedTask(&task, stack, sizeof(stack));
+  stack[10] = 0x00;
+
+  /* Bytes holding the paint pattern above the deepest used byte are counted */
+  ASSERT(6 == Scheduler_GetStackHighWaterMark(&task));
+}
+
+UNIT_TEST(StackHighWaterMark_4)
+{
+  Task task;
+  uint8_t stack[16];
+
+  InitPaintedTask(&task, stack, sizeof(stack));
+  stack[0] = 0x00;
+
+  ASSERT(16 == Scheduler_GetStackHighWaterMark(&task));
+}
+
+/**
+ * Initialize a Task whose stack is the buffer @p stack, protected by
+ * STACK_GUARD_WORD placed in its 2 first bytes.
+ *
+ * @param task A pointer to the Task to initialize.
+ * @param stack A pointer to the buffer to use as guard and stack.
+ * @param size The size of the buffer @p stack.
+ */
+static void
+InitGuardedTask(Task * const task, uint8_t * const stack, const size_t size)
+{
+  *((uint16_t *)stack) = STACK_GUARD_WORD;
+
+  task->stackSize = size - sizeof(uint16_t);
+  task->stackOrigin = &stack[size - 1];
+}
+
+UNIT_TEST(StackOverflow_1)
+{
+  Task task;
+  uint8_t stack[18];
+
+  InitGuardedTask(&task, stack, sizeof(stack));
+
+  ASSERT(!Scheduler_IsStackOverflowed(&task, &stack[17]));
+  ASSERT(!Scheduler_IsStackOverflowed(&task, &stack[8]));
+}
+
+UNIT_TEST(StackOverflow_2)
+{
+  Task task;
+  uint8_t stack[18];
+
+  InitGuardedTask(&task, stack, sizeof(stack));
+
+  /* The stack is full, but not overflowed */
+  ASSERT(!Scheduler_IsStackOverflowed(&task, &stack[1]));
+  ASSERT(Scheduler_IsStackOverflowed(&task, &stack[0]));
+}
+
+UNIT_TEST(StackOverflow_3)
+{
+  Task task;
+  uint8_t stack[18];
+
+  InitGuardedTask(&task, stack, sizeof(stack));
+
+  ASSERT(Scheduler_IsStackOverflowed(&task, &stack[17] + 1));
+}
+
+UNIT_TEST(StackOverflow_4)
+{
+  Task task;
+  uint8_t stack[18];
+
+  InitGuardedTask(&task, stack, sizeof(stack));
+  stack[1] = 0x00;
+
+  ASSERT(Scheduler_IsStackOverflowed(&task, &stack[17]));
+}
+
+UNIT_TEST(StackOverflow_5)
+{
+  Task task;
+  uint8_t stack[18];
+
+  InitGuardedTask(&task, stack, sizeof(stack));
+  stack[0] = 0x00;
+
+  ASSERT(Scheduler_IsStackOverflowed(&task, &stack[17]));
+}
+
+/**
+ * Measure a critical section, with interrupts disabled so it's not mixed with
+ * the critical sections of the kernel.
+ *
+ * @param location The location of the critical section.
+ * @param iterations The number of iterations to spin in the critical section.
+ * @param longest A pointer to the Lz_CriticalSection to fill with the longest
+ *                critical section recorded.
+ */
+static void
+MeasureCriticalSection(const uint16_t location,
+                       const uint16_t iterations,
+                       Lz_CriticalSection * const longest)
+{
+  volatile uint16_t counter = iterations;
+
+  Arch_DisableInterrupts();
+
+  Arch_RecordCriticalSectionBegin(location, LZ_CRITICAL_SECTION_NO_INTERRUPT);
+  while (counter > 0) {
+    --counter;
+  }
+  Arch_RecordCriticalSectionEnd();
+
+  Arch_GetLongestCriticalSection(longest);
+
+  Arch_EnableInterrupts();
+}
+
+UNIT_TEST(CriticalSection_1)
+{
+  Lz_CriticalSection longest;
+
+  Arch_DisableInterrupts();
+  Arch_ResetLongestCriticalSection();
+  Arch_EnableInterrupts();
+
+  MeasureCriticalSection(0x1234, 1000, &longest);
+
+  ASSERT(0x1234 == longest.location);
+  ASSERT(LZ_CRITICAL_SECTION_NO_INTERRUPT == longest.interruptCode);
+  ASSERT(longest.duration > 0);
+}
+
+UNIT_TEST(CriticalSection_2)
+{
+  Lz_CriticalSection first;
+  Lz_CriticalSection second;
+
+  Arch_DisableInterrupts();
+  Arch_ResetLongestCriticalSection();
+  Arch_EnableInterrupts();
+
+  MeasureCriticalSection(0x1234, 1000, &first);
+  MeasureCriticalSection(0x4321, 10, &second);
+
+  /* A shorter critical section doesn't replace the longest one */
+  ASSERT(0x1234 == second.location);
+  ASSERT(first.duration == second.duration);
+
+  MeasureCriticalSection(0x4321, 2000, &second);
+
+  ASSERT(0x4321 == second.location);
+  ASSERT(second.duration > first.duration);
+}
+
+UNIT_TEST(CriticalSection_3)
+{
+  Lz_CriticalSection longest;
+
+  Arch_DisableInterrupts();
+  /* Close the critical section opened when disabling interrupts, if any */
+  Arch_RecordCriticalSectionEnd();
+  Arch_ResetLongestCriticalSection();
+  /* The end of a critical section that has not been recorded is ignored */
+  Arch_RecordCriticalSectionEnd();
+  Arch_GetLongestCriticalSection(&longest);
+  Arch_EnableInterrupts();
+
+  ASSERT(0 == longest.duration);
+  ASSERT(LZ_CRITICAL_SECTION_NO_INTERRUPT == longest.interruptCode);
+}
+
 void
 ExecuteTests(void)
 {
@@ -1576,6 +1854,18 @@ ExecuteTests(void)
   ReverseBytesOfFunctionPointer_1();
   ReverseBytesOfFunctionPointer_2();
   ReverseBytesOfFunctionPointer_3();
+  StackHighWaterMark_1();
+  StackHighWaterMark_2();
+  StackHighWaterMark_3();
+  StackHighWaterMark_4();
+  StackOverflow_1();
+  StackOverflow_2();
+  StackOverflow_3();
+  StackOverflow_4();
+  StackOverflow_5();
+  CriticalSection_1();
+  CriticalSection_2();
+  CriticalSection_3();
   LoadU8FromProgmem_1();
   LoadU8FromProgmem_2();
   LoadPointerFromProgmem_1();
@@ -1604,6 +1894,8 @@ ExecuteTests(void)
   List_AppendList_2();
   List_AppendList_3();
   List_AppendList_4();
+  List_InsertBefore_1();
+  List_InsertAfter_1();
   Division_1();
   Division_2();
   Division_3();
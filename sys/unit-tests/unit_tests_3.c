@@ -8,11 +8,12 @@
  * @brief Lazuli kernel unit tests part 3.
  * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
  *
- * This file contains unit tests to test string related functions.
+ * This file contains unit tests to test string and memory related functions.
  */
 
 #include "unit_tests_common.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #include <Lazuli/common.h>
@@ -50,6 +51,165 @@ UNIT_TEST(Strlen_6)
   ASSERT(6 == strlen("12\r\n34"));
 }
 
+UNIT_TEST(Memcpy_1)
+{
+  const char source[] = "abcdefg";
+  char destination[8] = "0000000";
+
+  ASSERT(destination == memcpy(destination, source, 5));
+  ASSERT(StringsAreEqual("abcde00", destination));
+}
+
+UNIT_TEST(Memcpy_2)
+{
+  const char source[] = "abc";
+  char destination[4] = "xyz";
+
+  ASSERT(destination == memcpy(destination, source, 0));
+  ASSERT(StringsAreEqual("xyz", destination));
+}
+
+UNIT_TEST(Memcpy_3)
+{
+  uint8_t source[37];
+  uint8_t destination[37];
+  uint8_t i;
+
+  for (i = 0; i < sizeof(source); ++i) {
+    source[i] = i * 7;
+    destination[i] = 0;
+  }
+
+  memcpy(destination, source, sizeof(source));
+
+  for (i = 0; i < sizeof(source); ++i) {
+    ASSERT(destination[i] == (uint8_t)(i * 7));
+  }
+}
+
+UNIT_TEST(Memmove_1)
+{
+  char buffer[] = "123456789";
+
+  ASSERT(buffer + 2 == memmove(buffer + 2, buffer, 6));
+  ASSERT(StringsAreEqual("121234569", buffer));
+}
+
+UNIT_TEST(Memmove_2)
+{
+  char buffer[] = "123456789";
+
+  ASSERT(buffer == memmove(buffer, buffer + 3, 6));
+  ASSERT(StringsAreEqual("456789789", buffer));
+}
+
+UNIT_TEST(Memmove_3)
+{
+  char buffer[] = "123456789";
+
+  memmove(buffer, buffer, 9);
+  ASSERT(StringsAreEqual("123456789", buffer));
+}
+
+UNIT_TEST(Memset_1)
+{
+  char buffer[] = "123456789";
+
+  ASSERT(buffer + 1 == memset(buffer + 1, '-', 7));
+  ASSERT(StringsAreEqual("1-------9", buffer));
+}
+
+UNIT_TEST(Memset_2)
+{
+  char buffer[] = "123";
+
+  memset(buffer, 'x', 0);
+  ASSERT(StringsAreEqual("123", buffer));
+}
+
+UNIT_TEST(Memset_3)
+{
+  uint8_t buffer[4] = {1, 2, 3, 4};
+
+  memset(buffer, 0x1ff, 3);
+  ASSERT(0xff == buffer[0]);
+  ASSERT(0xff == buffer[1]);
+  ASSERT(0xff == buffer[2]);
+  ASSERT(4 == buffer[3]);
+}
+
+UNIT_TEST(Memcmp_1)
+{
+  ASSERT(0 == memcmp("abcd", "abcd", 4));
+}
+
+UNIT_TEST(Memcmp_2)
+{
+  ASSERT(memcmp("abcd", "abzd", 4) < 0);
+  ASSERT(memcmp("abzd", "abcd", 4) > 0);
+}
+
+UNIT_TEST(Memcmp_3)
+{
+  ASSERT(0 == memcmp("abcd", "abzd", 2));
+  ASSERT(0 == memcmp("a", "b", 0));
+}
+
+UNIT_TEST(Memcmp_4)
+{
+  const uint8_t a[] = {0x01, 0xf0};
+  const uint8_t b[] = {0x01, 0x10};
+
+  ASSERT(0xe0 == memcmp(a, b, sizeof(a)));
+  ASSERT(-0xe0 == memcmp(b, a, sizeof(a)));
+}
+
+UNIT_TEST(Strcmp_1)
+{
+  ASSERT(0 == strcmp("test", "test"));
+  ASSERT(0 == strcmp("", ""));
+}
+
+UNIT_TEST(Strcmp_2)
+{
+  ASSERT(strcmp("test", "tesT") > 0);
+  ASSERT(strcmp("tesT", "test") < 0);
+}
+
+UNIT_TEST(Strcmp_3)
+{
+  ASSERT(strcmp("tes", "test") < 0);
+  ASSERT(strcmp("test", "tes") > 0);
+  ASSERT(strcmp("", "a") < 0);
+}
+
+UNIT_TEST(Strncpy_1)
+{
+  char buffer[] = "xxxxxxxx";
+
+  ASSERT(buffer == strncpy(buffer, "abc", 6));
+  ASSERT(StringsAreEqual("abc", buffer));
+  ASSERT('\0' == buffer[4]);
+  ASSERT('\0' == buffer[5]);
+  ASSERT('x' == buffer[6]);
+}
+
+UNIT_TEST(Strncpy_2)
+{
+  char buffer[] = "xxxxxxxx";
+
+  strncpy(buffer, "abcdef", 3);
+  ASSERT(StringsAreEqual("abcxxxxx", buffer));
+}
+
+UNIT_TEST(Strncpy_3)
+{
+  char buffer[] = "xxxx";
+
+  strncpy(buffer, "abc", 0);
+  ASSERT(StringsAreEqual("xxxx", buffer));
+}
+
 void
 ExecuteTests(void)
 {
@@ -59,4 +219,23 @@ ExecuteTests(void)
   Strlen_4();
   Strlen_5();
   Strlen_6();
+  Memcpy_1();
+  Memcpy_2();
+  Memcpy_3();
+  Memmove_1();
+  Memmove_2();
+  Memmove_3();
+  Memset_1();
+  Memset_2();
+  Memset_3();
+  Memcmp_1();
+  Memcmp_2();
+  Memcmp_3();
+  Memcmp_4();
+  Strcmp_1();
+  Strcmp_2();
+  Strcmp_3();
+  Strncpy_1();
+  Strncpy_2();
+  Strncpy_3();
 }
@@ -0,0 +1,295 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel unit tests part 4.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains unit tests to test 32-bit integer arithmetic.
+ */
+
+#include "unit_tests_common.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+
+#include <Lazuli/sys/arch/arch.h>
+
+DEPENDENCY_ON_MODULE(ARITHMETIC_32);
+DEPENDENCY_ON_MODULE(PRINTF);
+DEPENDENCY_ON_MODULE(SERIAL);
+
+UNIT_TEST(Division32_1)
+{
+  const uint32_t numerator = 15UL;
+  const uint32_t denominator = 1UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(15UL == d.quotient);
+  ASSERT(0UL == d.remainder);
+}
+
+UNIT_TEST(Division32_2)
+{
+  const uint32_t numerator = 4294967295UL;
+  const uint32_t denominator = 1UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(4294967295UL == d.quotient);
+  ASSERT(0UL == d.remainder);
+}
+
+UNIT_TEST(Division32_3)
+{
+  const uint32_t numerator = 4294967295UL;
+  const uint32_t denominator = 4294967295UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(1UL == d.quotient);
+  ASSERT(0UL == d.remainder);
+}
+
+UNIT_TEST(Division32_4)
+{
+  const uint32_t numerator = 4294967295UL;
+  const uint32_t denominator = 10UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(429496729UL == d.quotient);
+  ASSERT(5UL == d.remainder);
+}
+
+UNIT_TEST(Division32_5)
+{
+  const uint32_t numerator = 1000000UL;
+  const uint32_t denominator = 7UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(142857UL == d.quotient);
+  ASSERT(1UL == d.remainder);
+}
+
+UNIT_TEST(Division32_6)
+{
+  const uint32_t numerator = 65536UL;
+  const uint32_t denominator = 65535UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(1UL == d.quotient);
+  ASSERT(1UL == d.remainder);
+}
+
+UNIT_TEST(Division32_7)
+{
+  const uint32_t numerator = 123456789UL;
+  const uint32_t denominator = 12345UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(10000UL == d.quotient);
+  ASSERT(6789UL == d.remainder);
+}
+
+UNIT_TEST(Division32_8)
+{
+  const uint32_t numerator = 7UL;
+  const uint32_t denominator = 4294967295UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(0UL == d.quotient);
+  ASSERT(7UL == d.remainder);
+}
+
+UNIT_TEST(Division32_9)
+{
+  const uint32_t numerator = 0UL;
+  const uint32_t denominator = 3UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(0UL == d.quotient);
+  ASSERT(0UL == d.remainder);
+}
+
+UNIT_TEST(Division32_10)
+{
+  const uint32_t numerator = 2147483648UL;
+  const uint32_t denominator = 2UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(1073741824UL == d.quotient);
+  ASSERT(0UL == d.remainder);
+}
+
+UNIT_TEST(Division32_11)
+{
+  const uint32_t numerator = 3000000000UL;
+  const uint32_t denominator = 65537UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(45775UL == d.quotient);
+  ASSERT(43825UL == d.remainder);
+}
+
+UNIT_TEST(Division32_12)
+{
+  const uint32_t numerator = 99999UL;
+  const uint32_t denominator = 100000UL;
+
+  U32DivisionResult d = Arch_Divide_U32(numerator, denominator);
+
+  printf("D:num=%lu den=%lu quot=%lu rem=%lu" LZ_CONFIG_SERIAL_NEWLINE,
+         numerator,
+         denominator,
+         d.quotient,
+         d.remainder);
+
+  ASSERT(0UL == d.quotient);
+  ASSERT(99999UL == d.remainder);
+}
+
+UNIT_TEST(Multiplication32_1)
+{
+  ASSERT(0UL == Arch_Multiply_U32(0UL, 12345678UL));
+}
+
+UNIT_TEST(Multiplication32_2)
+{
+  ASSERT(4294967295UL == Arch_Multiply_U32(1UL, 4294967295UL));
+}
+
+UNIT_TEST(Multiplication32_3)
+{
+  ASSERT(4294836225UL == Arch_Multiply_U32(65535UL, 65535UL));
+}
+
+UNIT_TEST(Multiplication32_4)
+{
+  ASSERT(0UL == Arch_Multiply_U32(65536UL, 65536UL));
+}
+
+UNIT_TEST(Multiplication32_5)
+{
+  ASSERT(123456000UL == Arch_Multiply_U32(123456UL, 1000UL));
+}
+
+UNIT_TEST(Multiplication32_6)
+{
+  ASSERT(1UL == Arch_Multiply_U32(4294967295UL, 4294967295UL));
+}
+
+UNIT_TEST(Multiplication32_7)
+{
+  ASSERT(4294967295UL == Arch_Multiply_U32(3UL, 1431655765UL));
+}
+
+UNIT_TEST(Multiplication32_8)
+{
+  ASSERT(4294900000UL == Arch_Multiply_U32(100000UL, 42949UL));
+}
+
+void
+ExecuteTests(void)
+{
+  Division32_1();
+  Division32_2();
+  Division32_3();
+  Division32_4();
+  Division32_5();
+  Division32_6();
+  Division32_7();
+  Division32_8();
+  Division32_9();
+  Division32_10();
+  Division32_11();
+  Division32_12();
+  Multiplication32_1();
+  Multiplication32_2();
+  Multiplication32_3();
+  Multiplication32_4();
+  Multiplication32_5();
+  Multiplication32_6();
+  Multiplication32_7();
+  Multiplication32_8();
+}
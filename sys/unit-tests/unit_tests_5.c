@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel unit tests part 5.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains unit tests to test the kernel events trace.
+ */
+
+#include "unit_tests_common.h"
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/trace.h>
+
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/trace.h>
+
+DEPENDENCY_ON_MODULE(SERIAL);
+DEPENDENCY_ON_MODULE(TRACE);
+
+/**
+ * Remove all the records from the trace.
+ */
+static void
+EmptyTrace(void)
+{
+  Lz_TraceRecord record;
+
+  while (0 != Lz_Trace_Drain(&record, 1));
+}
+
+UNIT_TEST(Trace_1)
+{
+  Lz_TraceRecord records[2];
+
+  EmptyTrace();
+
+  ASSERT(0 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+}
+
+UNIT_TEST(Trace_2)
+{
+  Lz_TraceRecord records[2];
+
+  EmptyTrace();
+
+  Trace_Record(LZ_TRACE_EVENT_MUTEX_BLOCK, 3);
+
+  ASSERT(1 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+  ASSERT(LZ_TRACE_EVENT_MUTEX_BLOCK == records[0].event);
+  ASSERT(3 == records[0].data);
+  ASSERT(0 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+}
+
+UNIT_TEST(Trace_3)
+{
+  Lz_TraceRecord records[2];
+
+  EmptyTrace();
+
+  Trace_Record(LZ_TRACE_EVENT_INTERRUPT, 7);
+  Trace_Record(LZ_TRACE_EVENT_TASK_WAKEUP, 1);
+  Trace_Record(LZ_TRACE_EVENT_CONTEXT_SWITCH, 1);
+
+  ASSERT(2 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+  ASSERT(LZ_TRACE_EVENT_INTERRUPT == records[0].event);
+  ASSERT(7 == records[0].data);
+  ASSERT(LZ_TRACE_EVENT_TASK_WAKEUP == records[1].event);
+  ASSERT(1 == records[1].data);
+
+  ASSERT(1 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+  ASSERT(LZ_TRACE_EVENT_CONTEXT_SWITCH == records[0].event);
+}
+
+UNIT_TEST(Trace_4)
+{
+  Lz_TraceRecord record;
+  const uint16_t lostRecordsCount = Lz_Trace_GetLostRecordsCount();
+  uint8_t i;
+
+  EmptyTrace();
+
+  for (i = 0; i < LZ_CONFIG_TRACE_BUFFER_SIZE + 2; ++i) {
+    Trace_Record(LZ_TRACE_EVENT_TIMER_EXPIRY, i);
+  }
+
+  ASSERT((uint16_t)(lostRecordsCount + 2) == Lz_Trace_GetLostRecordsCount());
+
+  /* The 2 oldest records have been overwritten */
+  ASSERT(1 == Lz_Trace_Drain(&record, 1));
+  ASSERT(2 == record.data);
+
+  for (i = 3; i < LZ_CONFIG_TRACE_BUFFER_SIZE + 2; ++i) {
+    ASSERT(1 == Lz_Trace_Drain(&record, 1));
+    ASSERT(i == record.data);
+  }
+
+  ASSERT(0 == Lz_Trace_Drain(&record, 1));
+}
+
+UNIT_TEST(Trace_5)
+{
+  Lz_TraceRecord records[2];
+
+  EmptyTrace();
+
+  Trace_Record(LZ_TRACE_EVENT_TASK_ACTIVATION, 0);
+  Trace_IncrementTick();
+  Trace_Record(LZ_TRACE_EVENT_TASK_ACTIVATION, 1);
+
+  ASSERT(2 == Lz_Trace_Drain(records, ELEMENTS_COUNT(records)));
+  ASSERT(1 == (uint16_t)(records[1].tick - records[0].tick));
+}
+
+UNIT_TEST(Trace_6)
+{
+  Lz_TraceRecord record;
+  InterruptsStatus interruptsStatus;
+
+  EmptyTrace();
+
+  interruptsStatus = Arch_DisableInterruptsGetStatus();
+  Trace_RecordInterruptsDisabled(LZ_TRACE_EVENT_TASK_WAKEUP, 5);
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  ASSERT(1 == Lz_Trace_Drain(&record, 1));
+  ASSERT(LZ_TRACE_EVENT_TASK_WAKEUP == record.event);
+  ASSERT(5 == record.data);
+  ASSERT(0 == Lz_Trace_Drain(&record, 1));
+}
+
+void
+ExecuteTests(void)
+{
+  Trace_1();
+  Trace_2();
+  Trace_3();
+  Trace_4();
+  Trace_5();
+  Trace_6();
+}
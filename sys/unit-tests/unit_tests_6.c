@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * This file is part of Lazuli.
+ */
+
+/**
+ * @file
+ * @brief Lazuli kernel unit tests part 6.
+ * @copyright 2020, Remi Andruccioli <remi.andruccioli@gmail.com>
+ *
+ * This file contains unit tests to test the statistical profiler and the
+ * interrupt latency measurement.
+ */
+
+#include "unit_tests_common.h"
+
+#include <stdint.h>
+
+#include <Lazuli/common.h>
+#include <Lazuli/config.h>
+#include <Lazuli/interrupt_latency.h>
+#include <Lazuli/profiler.h>
+
+#include <Lazuli/sys/arch/AVR/interrupts.h>
+#include <Lazuli/sys/arch/arch.h>
+#include <Lazuli/sys/interrupt_latency.h>
+#include <Lazuli/sys/profiler.h>
+#include <Lazuli/sys/scheduler.h>
+
+DEPENDENCY_ON_MODULE(SERIAL);
+DEPENDENCY_ON_MODULE(INTERRUPT_LATENCY);
+DEPENDENCY_ON_MODULE(PROFILER);
+
+/**
+ * A task ID that is never used by a registered task, so the samples of the
+ * tests are not mixed with the samples taken at clock ticks.
+ */
+#define TEST_TASK_ID ((uint8_t)200U)
+
+/**
+ * Get the number of samples of a program counter for a task.
+ *
+ * @param taskId The ID of the task.
+ * @param pc The program counter.
+ *
+ * @return The number of samples, or 0 if the program counter has never been
+ *         sampled for this task.
+ */
+static uint16_t
+GetSamplesCount(const uint8_t taskId, const uint16_t pc)
+{
+  Lz_ProfilerSample sample;
+  uint8_t cursor = 0;
+
+  while (0 != Lz_Profiler_GetSamples(&sample, 1, &cursor)) {
+    if (taskId == sample.taskId && pc == sample.pc) {
+      return sample.count;
+    }
+  }
+
+  return 0;
+}
+
+UNIT_TEST(Profiler_1)
+{
+  Lz_Profiler_Reset();
+
+  ASSERT(0 == GetSamplesCount(TEST_TASK_ID, 0x1234));
+  ASSERT(0 == Lz_Profiler_GetLostSamplesCount());
+}
+
+UNIT_TEST(Profiler_2)
+{
+  Lz_Profiler_Reset();
+
+  Profiler_Sample(TEST_TASK_ID, 0x1234);
+  Profiler_Sample(TEST_TASK_ID, 0x1234);
+  Profiler_Sample(TEST_TASK_ID, 0x1235);
+  Profiler_Sample(TEST_TASK_ID + 1, 0x1234);
+
+  ASSERT(2 == GetSamplesCount(TEST_TASK_ID, 0x1234));
+  ASSERT(1 == GetSamplesCount(TEST_TASK_ID, 0x1235));
+  ASSERT(1 == GetSamplesCount(TEST_TASK_ID + 1, 0x1234));
+}
+
+UNIT_TEST(Profiler_3)
+{
+  uint8_t i;
+
+  Lz_Profiler_Reset();
+
+  /* Samples from clock ticks can also take entries of the table */
+  for (i = 0; i < LZ_CONFIG_PROFILER_TABLE_SIZE + 2; ++i) {
+    Profiler_Sample(TEST_TASK_ID, 0x0100 + i);
+  }
+
+  ASSERT(Lz_Profiler_GetLostSamplesCount() >= 2);
+  ASSERT(1 == GetSamplesCount(TEST_TASK_ID, 0x0100));
+
+  /* Already sampled program counters are still counted */
+  Profiler_Sample(TEST_TASK_ID, 0x0100);
+  ASSERT(2 == GetSamplesCount(TEST_TASK_ID, 0x0100));
+}
+
+UNIT_TEST(Profiler_4)
+{
+  Profiler_Sample(TEST_TASK_ID, 0x1234);
+
+  Lz_Profiler_Reset();
+
+  ASSERT(0 == GetSamplesCount(TEST_TASK_ID, 0x1234));
+  ASSERT(0 == Lz_Profiler_GetLostSamplesCount());
+}
+
+/**
+ * Record a latency for an interrupt, with a timestamp taken in the past.
+ *
+ * @param interruptCode The code of the interrupt.
+ * @param age The number of system timer counts between the timestamp and now.
+ */
+static void
+RecordLatency(const uint8_t interruptCode, const uint32_t age)
+{
+  const InterruptsStatus interruptsStatus = Arch_DisableInterruptsGetStatus();
+  const uint32_t timestamp = Scheduler_GetTimestamp() - age;
+
+  Arch_RestoreInterruptsStatus(interruptsStatus);
+
+  InterruptLatency_Record(interruptCode, timestamp);
+}
+
+UNIT_TEST(InterruptLatency_1)
+{
+  Lz_InterruptLatency latency;
+  uint8_t i;
+
+  Lz_InterruptLatency_Reset();
+
+  ASSERT(Lz_InterruptLatency_Get(INT_INT0, &latency));
+  ASSERT(0 == latency.count);
+  ASSERT(0 == latency.min);
+  ASSERT(0 == latency.max);
+
+  for (i = 0; i < LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE; ++i) {
+    ASSERT(0 == latency.histogram[i]);
+  }
+
+  ASSERT(!Lz_InterruptLatency_Get(INT_LAST_ENTRY + 1, &latency));
+  ASSERT(!Lz_InterruptLatency_Get(INT_INT0, NULL));
+}
+
+UNIT_TEST(InterruptLatency_2)
+{
+  Lz_InterruptLatency latency;
+
+  Lz_InterruptLatency_Reset();
+
+  RecordLatency(INT_INT0, 100);
+  RecordLatency(INT_INT0, 200);
+
+  ASSERT(Lz_InterruptLatency_Get(INT_INT0, &latency));
+  ASSERT(2 == latency.count);
+  ASSERT(latency.min >= 100 && latency.min < 200);
+  ASSERT(latency.max >= 200);
+  ASSERT(2 == latency.histogram[0]);
+
+  /* Other interrupts are left untouched */
+  ASSERT(Lz_InterruptLatency_Get(INT_INT1, &latency));
+  ASSERT(0 == latency.count);
+}
+
+UNIT_TEST(InterruptLatency_3)
+{
+  Lz_InterruptLatency latency;
+
+  Lz_InterruptLatency_Reset();
+
+  /* Latencies beyond the histogram are counted in the last bucket */
+  RecordLatency(INT_INT0, 0x100000UL);
+
+  ASSERT(Lz_InterruptLatency_Get(INT_INT0, &latency));
+  ASSERT(1 == latency.count);
+  ASSERT(UINT16_MAX == latency.max);
+  ASSERT(1 ==
+         latency.histogram[LZ_CONFIG_INTERRUPT_LATENCY_HISTOGRAM_SIZE - 1]);
+}
+
+UNIT_TEST(InterruptLatency_4)
+{
+  Lz_InterruptLatency latency;
+
+  RecordLatency(INT_INT0, 100);
+
+  Lz_InterruptLatency_Reset();
+
+  ASSERT(Lz_InterruptLatency_Get(INT_INT0, &latency));
+  ASSERT(0 == latency.count);
+  ASSERT(0 == latency.histogram[0]);
+}
+
+void
+ExecuteTests(void)
+{
+  Profiler_1();
+  Profiler_2();
+  Profiler_3();
+  Profiler_4();
+  InterruptLatency_1();
+  InterruptLatency_2();
+  InterruptLatency_3();
+  InterruptLatency_4();
+}
@@ -21,13 +21,15 @@
 #include <Lazuli/config.h>
 #include <Lazuli/serial.h>
 
+#include <Lazuli/sys/compiler.h>
+
 DEPENDENCY_ON_MODULE(SERIAL);
 
 void
 Assert(const bool cond, const uint16_t line)
 {
   if (!cond) {
-    printf("0x%x" LZ_CONFIG_SERIAL_NEWLINE, line);
+    printf_P(PSTR("0x%x" LZ_CONFIG_SERIAL_NEWLINE), line);
   }
 }
 